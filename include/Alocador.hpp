@@ -0,0 +1,108 @@
+#ifndef ALOCADOR_HPP
+#define ALOCADOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+/**
+ * @brief Contagem global dos bytes obtidos de `AlocadorPadrao`, para o `--mem-report`.
+ *
+ * @details Desativada, custa uma leitura atômica relaxada por alocação. Deve ser
+ * ativada antes de qualquer alocação das estruturas medidas: memória obtida
+ * antes e liberada depois da ativação seria descontada sem ter sido contada.
+ * Conta apenas os arrays de `Lista` e `Mapa`; strings e objetos alocados com
+ * `new` ficam de fora e são estimados pelo `RelatorioMemoria`.
+ */
+class ContadorAlocacoes {
+public:
+    static void ativar() { ativado.store(true, std::memory_order_relaxed); }
+    static bool ativo() { return ativado.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Soma `bytes` aos bytes vivos (negativo em uma liberação) e atualiza o pico.
+     */
+    static void registrar(long bytes) {
+        long vivos = bytesVivos.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        if (bytes > 0) {
+            alocacoes.fetch_add(1, std::memory_order_relaxed);
+            long pico = picoBytes.load(std::memory_order_relaxed);
+            while (vivos > pico && !picoBytes.compare_exchange_weak(pico, vivos, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    static long getBytesVivos() { return bytesVivos.load(std::memory_order_relaxed); }
+    static long getPicoBytes() { return picoBytes.load(std::memory_order_relaxed); }
+    static long getAlocacoes() { return alocacoes.load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<bool> ativado;
+    static std::atomic<long> bytesVivos;
+    static std::atomic<long> picoBytes;
+    static std::atomic<long> alocacoes;
+};
+
+/**
+ * @brief A memória de heap de uma estrutura: o total obtido e a parte ocupada por dados.
+ *
+ * A diferença é o desperdício: capacidade ainda não usada das listas, baldes
+ * vazios e cabeçalhos dos baldes de um mapa.
+ */
+struct UsoMemoria {
+    size_t alocados;
+    size_t usados;
+
+    UsoMemoria() : alocados(0), usados(0) {}
+    UsoMemoria(size_t alocados, size_t usados) : alocados(alocados), usados(usados) {}
+
+    UsoMemoria& operator+=(const UsoMemoria& outro) {
+        alocados += outro.alocados;
+        usados += outro.usados;
+        return *this;
+    }
+};
+
+/**
+ * @brief Alocador padrão de `Lista` e `Mapa`, baseado em `operator new`.
+ *
+ * @details Um alocador fornece memória não inicializada para `quantidade`
+ * elementos de qualquer tipo; a construção e a destruição dos elementos ficam a
+ * cargo do contêiner. Como um mesmo alocador serve aos vários tipos internos de
+ * um contêiner (a tabela e os baldes de um `Mapa`, por exemplo), os métodos são
+ * templates no tipo do elemento. Um alocador sem estado não ocupa espaço no
+ * contêiner, que o guarda como classe base.
+ *
+ * Alocadores alternativos (de contagem, de arena) seguem a mesma interface:
+ * @code
+ * template <typename T> T* alocar(int quantidade);
+ * template <typename T> void liberar(T* elementos, int quantidade);
+ * @endcode
+ */
+struct AlocadorPadrao {
+    /**
+     * @brief Reserva memória não inicializada para `quantidade` elementos.
+     * @throws std::bad_alloc se não houver memória.
+     */
+    template <typename T>
+    T* alocar(int quantidade) {
+        T* elementos = static_cast<T*>(::operator new(sizeof(T) * static_cast<size_t>(quantidade)));
+        if (ContadorAlocacoes::ativo()) {
+            ContadorAlocacoes::registrar(static_cast<long>(sizeof(T)) * quantidade);
+        }
+        return elementos;
+    }
+
+    /**
+     * @brief Libera memória obtida de `alocar` com a mesma `quantidade`.
+     */
+    template <typename T>
+    void liberar(T* elementos, int quantidade) {
+        if (ContadorAlocacoes::ativo()) {
+            ContadorAlocacoes::registrar(-static_cast<long>(sizeof(T)) * quantidade);
+        }
+        ::operator delete(elementos);
+    }
+};
+
+#endif // ALOCADOR_HPP
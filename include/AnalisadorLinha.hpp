@@ -0,0 +1,136 @@
+#ifndef ANALISADOR_LINHA_HPP
+#define ANALISADOR_LINHA_HPP
+
+#include <istream>
+#include <string>
+#include "Evento.hpp"
+#include "IndiceAssinaturas.hpp"
+
+/**
+ * @brief Os comandos que podem aparecer em uma linha de entrada.
+ */
+enum TipoComando {
+    COMANDO_EVENTO,    // EV: evento logístico
+    COMANDO_PACOTE,    // PC: histórico de um pacote
+    COMANDO_CLIENTE,   // CL: pacotes de um cliente
+    COMANDO_RANKING,   // RK: ranking de atividade
+    COMANDO_ROTA,      // RT: rota de um pacote
+    COMANDO_TRECHO,    // LA: latência de um trecho
+    COMANDO_CONTAGEM,  // CE: contagem de eventos por tipo
+    COMANDO_ASSINATURA,   // AS: assinatura de CL ou PC
+    COMANDO_CANCELAMENTO, // CA: cancelamento de uma assinatura
+    COMANDO_INVALIDO   // Linha desconhecida ou evento de tipo inválido
+};
+
+/**
+ * @brief Uma linha de entrada já interpretada.
+ *
+ * Apenas os campos pertinentes ao `tipo` são preenchidos.
+ */
+struct Comando {
+    TipoComando tipo;
+    int dataHora;       ///< Timestamp da linha.
+    Evento evento;      ///< O evento (EV).
+    int idPacote;       ///< O pacote consultado (PC, RT) ou assinado (AS e CA de PC).
+    std::string texto;  ///< O nome do cliente (CL, AS e CA de CL) ou a categoria do ranking (RK).
+    int parametro1;     ///< A quantidade (RK), o armazém de origem (LA) ou o `TipoAssinatura` (AS, CA).
+    int parametro2;     ///< O armazém de destino (LA).
+
+    Comando() : tipo(COMANDO_INVALIDO), dataHora(0), idPacote(-1), parametro1(0), parametro2(0) {}
+};
+
+/**
+ * @brief Interpretação das linhas do arquivo de entrada.
+ *
+ * @details As linhas seguem um layout rígido: timestamp de 7 dígitos com zeros à
+ * esquerda, comando de 2 letras, códigos de evento de 2 letras e IDs de pacote,
+ * armazém e seção com 3 dígitos. O caminho rápido decodifica esses campos em
+ * posições fixas: cada sequência de dígitos é convertida com aritmética SWAR
+ * (vários dígitos por operação em um registrador de 32 ou 64 bits) e cada código
+ * de 2 letras é empacotado em 16 bits e resolvido por um único `switch`.
+ * Linhas fora do layout (e.g., IDs com mais de 3 dígitos ou espaços extras)
+ * caem no caminho geral, baseado em `std::istream`.
+ */
+class AnalisadorLinha {
+public:
+    /**
+     * @brief Empacota um código de 2 letras em um inteiro de 16 bits.
+     */
+    static constexpr int codigo(char a, char b) {
+        return (static_cast<unsigned char>(a) << 8) | static_cast<unsigned char>(b);
+    }
+
+    /**
+     * @brief Converte um código de evento de 2 letras para o enum TipoEvento.
+     * @param p Ponteiro para os 2 caracteres do código.
+     * @return O tipo correspondente, ou INDEFINIDO.
+     */
+    static TipoEvento tipoEvento(const char* p);
+
+    /**
+     * @brief Converte uma string que representa um tipo de evento para o enum TipoEvento.
+     * @param s A string a ser convertida.
+     * @return O valor do enum correspondente.
+     */
+    static TipoEvento stringParaTipoEvento(const std::string& s);
+
+    /**
+     * @brief Decodifica 7 dígitos decimais com SWAR de 64 bits.
+     * @param p Ponteiro para os dígitos; 8 bytes a partir dele devem ser legíveis.
+     * @param valor Recebe o número decodificado.
+     * @return `false` se algum dos 7 caracteres não for um dígito.
+     */
+    static bool lerSeteDigitos(const char* p, int& valor);
+
+    /**
+     * @brief Decodifica 3 dígitos decimais com SWAR de 32 bits.
+     * @param p Ponteiro para os dígitos; 4 bytes a partir dele devem ser legíveis.
+     * @param valor Recebe o número decodificado.
+     * @return `false` se algum dos 3 caracteres não for um dígito.
+     */
+    static bool lerTresDigitos(const char* p, int& valor);
+
+    /**
+     * @brief Lê o cabeçalho fixo "TTTTTTT XX" de uma linha.
+     * @param linha A linha de entrada.
+     * @param dataHora Recebe o timestamp.
+     * @param comando Recebe o código empacotado do comando (ver `codigo`).
+     * @return `false` se a linha não começar no layout fixo.
+     */
+    static bool analisarCabecalho(const std::string& linha, int& dataHora, int& comando);
+
+    /**
+     * @brief Caminho rápido: interpreta uma linha de evento no layout fixo.
+     * @param linha A linha de entrada.
+     * @param ev Recebe o evento interpretado; os campos que o tipo não usa ficam com o valor padrão.
+     * @return `false` se a linha não for um evento válido no layout fixo; nesse
+     *         caso ela deve ser tratada pelo caminho geral.
+     */
+    static bool analisarEventoRapido(const std::string& linha, Evento& ev);
+
+    /**
+     * @brief Caminho geral: lê os campos de um evento após o comando "EV".
+     * @param ss O fluxo posicionado logo após "EV".
+     * @param ev Recebe o evento; deve chegar com o valor padrão e `ev.dataHora` preenchido.
+     * @return `false` se o tipo do evento for desconhecido.
+     */
+    static bool analisarCamposEvento(std::istream& ss, Evento& ev);
+
+    /**
+     * @brief Interpreta qualquer linha de entrada, tentando primeiro o caminho rápido.
+     * @param linha A linha de entrada.
+     * @param comando Recebe o comando interpretado.
+     * @return `false` se a linha não contiver um comando válido.
+     */
+    static bool analisarLinha(const std::string& linha, Comando& comando);
+
+    /**
+     * @brief Caminho geral completo para uma linha de evento.
+     * @param linha A linha de entrada.
+     * @param ev Recebe o evento interpretado.
+     * @return `true` se a linha for um evento de tipo conhecido.
+     */
+    static bool analisarEventoGeral(const std::string& linha, Evento& ev);
+};
+
+#endif // ANALISADOR_LINHA_HPP
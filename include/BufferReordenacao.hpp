@@ -0,0 +1,79 @@
+#ifndef BUFFER_REORDENACAO_HPP
+#define BUFFER_REORDENACAO_HPP
+
+#include "Lista.hpp"
+#include "AnalisadorLinha.hpp"
+
+/**
+ * @brief Reordena um fluxo de comandos que chega com atraso limitado.
+ *
+ * @details Feeds de vários armazéns chegam com defasagem entre si. O buffer
+ * aceita eventos atrasados em até `atrasoMaximo` unidades de tempo em relação ao
+ * maior timestamp de evento já recebido e os libera em ordem de tempo (e de
+ * chegada, nos empates), guardando-os em um heap mínimo.
+ *
+ * A marca d'água é `maiorTempo - atrasoMaximo`: nenhum evento aceito no futuro
+ * terá timestamp menor que ela. Um comando só é liberado quando seu timestamp
+ * não passa da marca d'água, então uma consulta no instante `t` é respondida
+ * apenas quando todos os eventos até `t` já foram liberados e sua resposta é
+ * final. Eventos que chegam abaixo da marca d'água são descartados e contados.
+ */
+class BufferReordenacao {
+public:
+    /**
+     * @brief Construtor.
+     * @param atrasoMaximo O maior atraso aceito para um evento, em unidades de tempo.
+     */
+    explicit BufferReordenacao(int atrasoMaximo);
+
+    /**
+     * @brief Recebe o próximo comando do fluxo.
+     * @param comando O comando recebido.
+     * @return `false` se o comando for um evento além do atraso máximo e tiver sido descartado.
+     */
+    bool inserir(const Comando& comando);
+
+    /**
+     * @brief Retira o próximo comando liberado pela marca d'água.
+     * @param comando Recebe o comando.
+     * @return `false` se nenhum comando puder ser liberado ainda.
+     */
+    bool extrair(Comando& comando);
+
+    /**
+     * @brief Sinaliza o fim do fluxo, liberando todos os comandos retidos.
+     */
+    void encerrar();
+
+    /**
+     * @brief Retorna o número de eventos descartados por atraso.
+     */
+    long getDescartados() const { return descartados; }
+
+    /**
+     * @brief Retorna o número de comandos retidos.
+     */
+    int getTamanho() const { return heap.getTamanho(); }
+
+private:
+    struct Entrada {
+        Comando comando;
+        long sequencia; ///< Ordem de chegada, para desempate.
+    };
+
+    Lista<Entrada> heap; ///< Heap mínimo por (timestamp, ordem de chegada).
+    int atrasoMaximo;
+    int maiorTempo;      ///< Maior timestamp de evento recebido.
+    bool recebeuEvento;
+    bool encerrado;
+    long proximaSequencia;
+    long descartados;
+
+    bool liberado(const Entrada& entrada) const;
+
+    static bool precede(const Entrada& a, const Entrada& b);
+    void subir(int indice);
+    void descer(int indice);
+};
+
+#endif // BUFFER_REORDENACAO_HPP
@@ -0,0 +1,85 @@
+#ifndef CACHE_CONSULTAS_CLIENTE_HPP
+#define CACHE_CONSULTAS_CLIENTE_HPP
+
+#include <cstddef>
+#include <string>
+#include "Mapa.hpp"
+#include "MotorLogistico.hpp"
+
+/**
+ * @brief Cache das respostas já serializadas da consulta CL, com limite de memória.
+ *
+ * @details Cada entrada guarda, para um cliente, o corpo da resposta (contagem
+ * e eventos, sem o cabeçalho) e a `VersaoCliente` em que ele foi calculado.
+ * Uma consulta repetida sem eventos novos nos pacotes do cliente é respondida
+ * copiando esses bytes, sem refazer a seleção, a deduplicação e a ordenação.
+ * Entradas desatualizadas são descartadas ao serem encontradas. Quando a soma
+ * dos tamanhos ultrapassa o limite, as entradas menos usadas recentemente são
+ * removidas (LRU), mantidas em uma lista duplamente encadeada.
+ */
+class CacheConsultasCliente {
+public:
+    /**
+     * @brief Construtor.
+     * @param limiteBytes A memória máxima ocupada pelas entradas.
+     */
+    explicit CacheConsultasCliente(size_t limiteBytes);
+    ~CacheConsultasCliente();
+
+    CacheConsultasCliente(const CacheConsultasCliente&) = delete;
+    CacheConsultasCliente& operator=(const CacheConsultasCliente&) = delete;
+
+    /**
+     * @brief Busca a resposta de um cliente, se ainda for válida.
+     * @param nomeCliente O nome do cliente.
+     * @param tempo O timestamp da consulta.
+     * @param versao A versão atual dos dados do cliente.
+     * @return O corpo da resposta, ou `nullptr` se não houver entrada válida.
+     *         O ponteiro é invalidado pela próxima chamada a `armazenar`.
+     */
+    const std::string* buscar(const std::string& nomeCliente, int tempo, const VersaoCliente& versao);
+
+    /**
+     * @brief Guarda a resposta de um cliente, removendo entradas antigas se preciso.
+     *
+     * Respostas maiores que o limite inteiro do cache não são guardadas.
+     */
+    void armazenar(const std::string& nomeCliente, int tempo, const VersaoCliente& versao, const std::string& corpo);
+
+    long getAcertos() const { return acertos; }
+    long getFalhas() const { return falhas; }
+    size_t getBytesUsados() const { return bytesUsados; }
+    size_t getQuantidadeEntradas() const { return entradas.getTamanho(); }
+
+    /**
+     * @brief Retorna a memória real das entradas; `getBytesUsados` é a estimativa que o limite controla.
+     */
+    UsoMemoria getUsoMemoria() const;
+
+private:
+    struct Entrada {
+        std::string nomeCliente;
+        int tempo;             ///< Instante em que a resposta foi calculada.
+        VersaoCliente versao;  ///< Versão dos dados do cliente naquele instante.
+        std::string corpo;
+        Entrada* anterior;     ///< Vizinho usado mais recentemente.
+        Entrada* proxima;      ///< Vizinho usado menos recentemente.
+    };
+
+    Mapa<std::string, Entrada*> entradas;
+    Entrada* maisRecente;
+    Entrada* menosRecente;
+    size_t limiteBytes;
+    size_t bytesUsados;
+    long acertos;
+    long falhas;
+
+    static size_t custo(const Entrada* entrada);
+    static bool valida(const Entrada* entrada, int tempo, const VersaoCliente& versao);
+
+    void desvincular(Entrada* entrada);
+    void vincularNoInicio(Entrada* entrada);
+    void descartar(Entrada* entrada);
+};
+
+#endif // CACHE_CONSULTAS_CLIENTE_HPP
@@ -5,45 +5,74 @@
 #include <string>
 #include "Evento.hpp"
 #include "Lista.hpp"
-#include "Mapa.hpp"
+#include "MotorLogistico.hpp"
+#include "AnalisadorLinha.hpp"
+#include "CacheConsultasCliente.hpp"
+#include "RelatorioMemoria.hpp"
 
-/**
- * @brief Estrutura para armazenar os pacotes associados a um cliente.
- *
- * Separa os pacotes em duas listas: os que foram enviados pelo cliente e os que
- * ele deve receber.
- */
-struct PacotesCliente {
-    Lista<int> enviados;
-    Lista<int> aReceber;
-};
+class ExecutorParticionado;
 
 /**
  * @brief Orquestra o carregamento de dados e o processamento de simulações logísticas.
  *
  * Esta classe é responsável por ler um arquivo de entrada contendo eventos e consultas,
- * processá-los e gerar as saídas correspondentes. Ela gerencia a memória de todos
- * os objetos de evento e das estruturas de dados auxiliares.
+ * interpretá-los e gerar as saídas correspondentes no formato texto. A indexação
+ * e as consultas em si são delegadas ao `MotorLogistico`.
  */
 class Carregamento {
 public:
     /**
      * @brief Construtor.
      * @param filename O caminho para o arquivo de entrada a ser processado.
+     * @param opcoes Parâmetros opcionais de execução.
      */
-    Carregamento(const std::string& filename);
+    Carregamento(const std::string& filename, const OpcoesMotor& opcoes = OpcoesMotor());
 
     /**
      * @brief Destrutor.
-     * Libera toda a memória alocada dinamicamente, incluindo eventos e os mapas.
+     * Libera o motor e, com ele, todos os eventos e índices.
      */
     ~Carregamento();
 
+    /**
+     * @brief Define a memória máxima do cache de respostas da consulta CL.
+     * @param limiteBytes O limite em bytes; 0 desativa o cache.
+     */
+    void configurarCacheClientes(size_t limiteBytes);
+
+    /**
+     * @brief Ativa o relatório de memória por estrutura, escrito em stderr ao final da execução.
+     *
+     * A memória também é amostrada, sem relatório, a cada `LINHAS_POR_AMOSTRA_MEMORIA`
+     * linhas, para o pico de cada estrutura. O modo particionado relata só ao final e
+     * ignora `intervaloLinhas`; `main` recusa `--mem-report-every` com `--shards`.
+     *
+     * @param intervaloLinhas Linhas entre relatórios intermediários; 0 relata só ao final.
+     */
+    void configurarRelatorioMemoria(long intervaloLinhas);
+
     /**
      * @brief Inicia o processo de leitura e execução da simulação.
      */
     void executar();
 
+    /**
+     * @brief Executa a simulação escrevendo as respostas em `saida` em vez da saída padrão.
+     * @param saida O fluxo onde as respostas são escritas.
+     * @return `false` se o arquivo de entrada não puder ser aberto.
+     */
+    bool executar(std::ostream& saida);
+
+    /**
+     * @brief Retorna o número de linhas não vazias carregadas do arquivo.
+     */
+    long getLinhasLidas() const { return linhasLidas; }
+
+    /**
+     * @brief Retorna o número de bytes carregados do arquivo, incluindo as quebras de linha.
+     */
+    long getBytesLidos() const { return bytesLidos; }
+
     /**
      * @brief Executa a simulação com medição de tempo, separando I/O de processamento.
      *
@@ -52,48 +81,185 @@ public:
      */
     void executarComTiming();
 
+    /**
+     * @brief Mede a vazão (GB/s) do interpretador de linhas, sem indexar os eventos.
+     *
+     * Compara o caminho geral (stringstream) com o caminho rápido (SWAR) sobre
+     * as linhas do arquivo já carregadas em memória e imprime o resultado em stderr.
+     */
+    void executarBenchmarkAnalisador();
+
+    /**
+     * @brief Executa a simulação como um pipeline de quatro estágios concorrentes.
+     *
+     * Leitura do arquivo, interpretação das linhas, execução dos comandos sobre
+     * o motor e escrita da saída rodam cada um em sua thread e trocam lotes por
+     * filas `FilaSPSC`, sobrepondo E/S e interpretação à manutenção dos índices.
+     * Apenas o executor acessa o motor, então a saída é idêntica à de `executar()`.
+     */
+    void executarPipeline();
+
+    /**
+     * @brief Executa a simulação com os pacotes particionados entre várias threads.
+     *
+     * Delega a execução a um `ExecutorParticionado`; a saída é idêntica à de `executar()`.
+     *
+     * @param numParticoes O número de partições (e de threads de execução).
+     */
+    void executarParticionado(int numParticoes);
+
+    /**
+     * @brief Executa a simulação sobre uma entrada com eventos fora de ordem.
+     *
+     * Os comandos passam por um `BufferReordenacao`: eventos com atraso de até
+     * `atrasoMaximo` são reordenados e as consultas são retidas até que a marca
+     * d'água garanta que a resposta é final. O número de eventos descartados por
+     * atraso excessivo é impresso em stderr. Para uma entrada já ordenada, a
+     * saída é idêntica à de `executar()`.
+     *
+     * @param atrasoMaximo O maior atraso aceito para um evento, em unidades de tempo.
+     */
+    void executarComReordenacao(int atrasoMaximo);
+
 private:
     std::string filename;
-    Lista<Evento*> eventos; ///< Fonte da verdade, armazena todos os eventos criados.
+    OpcoesMotor opcoes;    ///< Parâmetros repassados aos motores.
+    MotorLogistico* motor; ///< Motor que mantém os eventos e os índices de consulta.
+    CacheConsultasCliente* cacheClientes; ///< Respostas de CL já serializadas, ou `nullptr` se desativado.
+    Lista<Notificacao> notificacoes;      ///< Notificações coletadas do motor; reaproveitada entre eventos.
+    long linhasLidas; ///< Linhas carregadas pela última leitura completa do arquivo.
+    long bytesLidos;  ///< Bytes dessas linhas, com as quebras de linha.
+    RelatorioMemoria* relatorioMemoria; ///< Contabilidade do `--mem-report`, ou `nullptr` se desativada.
+    long intervaloRelatorioMemoria;     ///< Linhas entre relatórios intermediários; 0 relata só ao final.
 
-    // Os mapas abaixo são índices para acesso rápido aos dados.
-    // Eles armazenam ponteiros para listas/objetos, que são alocados dinamicamente
-    // e devem ser liberadas manualmente no destrutor.
-    Mapa<int, Lista<Evento*>*>* mapaPacotes;         ///< Mapeia ID do pacote para sua lista de eventos.
-    Mapa<std::string, PacotesCliente*>* mapaClientes; ///< Mapeia nome do cliente para seus pacotes (enviados/a receber).
+    /**
+     * @brief Amostra a memória das estruturas e, se `escrever`, escreve o relatório em stderr.
+     * @param linhas As linhas de entrada em memória, ou `nullptr` se lidas em fluxo.
+     * @param rotulo Identifica a amostra no relatório.
+     * @param particionado O executor particionado, cujos motores substituem `motor`, ou `nullptr`.
+     */
+    void amostrarMemoria(const Lista<std::string>* linhas, const std::string& rotulo, bool escrever,
+                         const ExecutorParticionado* particionado = nullptr);
+
+    /**
+     * @brief Amostra ou relata a memória se o processamento cruzou um intervalo entre `anteriores` e `processadas` linhas.
+     */
+    void acompanharMemoria(const Lista<std::string>* linhas, long anteriores, long processadas);
+
+    /**
+     * @brief Lê todas as linhas não vazias do arquivo de entrada para a memória.
+     * @param linhas A lista que recebe as linhas.
+     * @return `false` se o arquivo não puder ser aberto.
+     */
+    bool carregarLinhas(Lista<std::string>& linhas);
+
+    /**
+     * @brief Processa as linhas em ordem, em lotes rastreados como spans "processarLinha".
+     * @param linhas As linhas de entrada, na ordem do arquivo.
+     * @param saida O fluxo onde as respostas são escritas.
+     */
+    void processarLinhas(const Lista<std::string>& linhas, std::ostream& saida);
 
     /**
      * @brief Processa uma única linha do arquivo de entrada.
      * @param linha A linha a ser processada.
+     * @param saida O fluxo onde as respostas são escritas.
      */
-    void processarLinha(const std::string& linha);
+    void processarLinha(const std::string& linha, std::ostream& saida);
+
+    /**
+     * @brief Executa um comando já interpretado: ingere o evento ou responde à consulta.
+     * @param comando O comando a ser executado.
+     * @param saida O fluxo onde as respostas de consultas são escritas.
+     */
+    void executarComando(const Comando& comando, std::ostream& saida);
 
     /**
      * @brief Processa uma consulta do tipo 'PC' (Pacote-Cliente).
      * @param tempo O timestamp da consulta.
      * @param idPacote O ID do pacote a ser consultado.
+     * @param saida O fluxo onde o resultado é escrito.
      */
-    void processarConsultaPacote(int tempo, int idPacote);
+    void processarConsultaPacote(int tempo, int idPacote, std::ostream& saida);
 
     /**
      * @brief Processa uma consulta do tipo 'CL' (Cliente).
+     *
+     * Se o cliente não teve eventos novos desde a última consulta, a resposta é
+     * copiada do `cacheClientes`.
+     *
      * @param tempo O timestamp da consulta.
      * @param nomeCliente O nome do cliente a ser consultado.
+     * @param saida O fluxo onde o resultado é escrito.
      */
-    void processarConsultaCliente(int tempo, const std::string& nomeCliente);
+    void processarConsultaCliente(int tempo, const std::string& nomeCliente, std::ostream& saida);
 
     /**
-     * @brief Converte uma string que representa um tipo de evento para o enum TipoEvento.
-     * @param s A string a ser convertida.
-     * @return O valor do enum correspondente.
+     * @brief Processa uma consulta do tipo 'RK' (ranking de atividade).
+     *
+     * O timestamp não é aplicado: os rankings são totais correntes e refletem
+     * todos os eventos ingeridos antes da consulta. Com a entrada ordenada por
+     * tempo, ou com o `BufferReordenacao`, isso equivale ao instante da consulta.
+     *
+     * @param tempo O timestamp da consulta.
+     * @param categoria "RE" (remetentes), "DE" (destinatários) ou "AM" (armazéns).
+     * @param quantidade O número de entradas a exibir (limitado à capacidade do ranking).
+     * @param saida O fluxo onde o resultado é escrito.
      */
-    static TipoEvento stringParaTipoEvento(const std::string& s);
+    void processarConsultaRanking(int tempo, const std::string& categoria, int quantidade, std::ostream& saida);
 
     /**
-     * @brief Ordena uma lista de eventos por tempo e, como critério de desempate, por ID do pacote.
-     * @param eventos A lista de eventos a ser ordenada.
+     * @brief Processa uma consulta do tipo 'RT' (rota do pacote).
+     * @param tempo O timestamp da consulta; apenas chegadas até ele são exibidas.
+     * @param idPacote O ID do pacote a ser consultado.
+     * @param saida O fluxo onde o resultado é escrito.
+     */
+    void processarConsultaRota(int tempo, int idPacote, std::ostream& saida);
+
+    /**
+     * @brief Processa uma consulta do tipo 'LA' (latência de um trecho).
+     *
+     * Como no RK, o timestamp não é aplicado: as estatísticas somam os trânsitos
+     * concluídos por todos os ARs ingeridos antes da consulta.
+     *
+     * @param tempo O timestamp da consulta (usado apenas no cabeçalho).
+     * @param origem O armazém de partida do trecho.
+     * @param destino O armazém de chegada do trecho.
+     * @param saida O fluxo onde o resultado é escrito.
+     */
+    void processarConsultaTrecho(int tempo, int origem, int destino, std::ostream& saida);
+
+    /**
+     * @brief Processa uma assinatura 'AS' de CL ou PC.
+     *
+     * A resposta é a da consulta assinada no instante da assinatura; daí em
+     * diante, cada evento que a altera produz um bloco 'NT' logo após sua ingestão.
+     *
+     * @param comando O comando, com o `TipoAssinatura` em `parametro1`.
+     * @param saida O fluxo onde o resultado é escrito.
+     */
+    void processarAssinatura(const Comando& comando, std::ostream& saida);
+
+    /**
+     * @brief Processa um cancelamento 'CA' de assinatura; a resposta é só o cabeçalho.
+     * @param comando O comando, com o `TipoAssinatura` em `parametro1`.
+     * @param saida O fluxo onde o resultado é escrito.
+     */
+    void processarCancelamento(const Comando& comando, std::ostream& saida);
+
+    /**
+     * @brief Escreve as notificações geradas pela ingestão de um evento.
+     * @param saida O fluxo onde as notificações são escritas.
+     */
+    void escreverNotificacoes(std::ostream& saida);
+
+    /**
+     * @brief Processa uma consulta do tipo 'CE' (contagem de eventos por tipo).
+     *
+     * @param tempo O timestamp da consulta; apenas eventos até ele são contados.
+     * @param saida O fluxo onde o resultado é escrito.
      */
-    static void ordenarEventos(Lista<Evento*>& eventos);
+    void processarConsultaContagem(int tempo, std::ostream& saida);
 };
 
 #endif // CARREGAMENTO_HPP
\ No newline at end of file
@@ -0,0 +1,102 @@
+#ifndef COLECAO_SEGMENTOS_HPP
+#define COLECAO_SEGMENTOS_HPP
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "Lista.hpp"
+#include "SegmentoDisco.hpp"
+
+/**
+ * @brief Conjunto ordenado de segmentos em disco que guardam o histórico despejado da memória.
+ *
+ * @details Cada despejo grava um novo segmento, mais recente que os anteriores.
+ * Para que o número de segmentos consultados não cresça com o histórico, sempre
+ * que `FATOR_MESCLA` segmentos consecutivos têm tamanhos da mesma ordem de
+ * grandeza, uma thread em segundo plano os intercala em um só (compactação em
+ * camadas, com custo de E/S O(n log n) no total). Os segmentos são imutáveis,
+ * então consultas e a mescla os leem sem travas; o resultado da mescla só é
+ * incorporado à lista em um despejo, pela thread dona da coleção. Se houver
+ * mais que `LIMITE_SEGMENTOS` segmentos, o despejo espera a mescla terminar.
+ *
+ * Os arquivos ficam em um diretório temporário exclusivo, apagado no destrutor.
+ */
+class ColecaoSegmentos {
+public:
+    static const int FATOR_MESCLA = 4;      ///< Quantos segmentos são intercalados por mescla.
+    static const int LIMITE_SEGMENTOS = 24; ///< Segmentos acima dos quais o despejo espera a mescla.
+
+    /**
+     * @brief Construtor. Cria o diretório dos segmentos.
+     * @param diretorioBase Onde criar o diretório; vazio usa `$TMPDIR` ou `/tmp`.
+     * @throws std::runtime_error se o diretório não puder ser criado.
+     */
+    explicit ColecaoSegmentos(const std::string& diretorioBase);
+
+    /**
+     * @brief Destrutor. Aguarda e descarta a mescla em andamento e apaga todos os segmentos.
+     */
+    ~ColecaoSegmentos();
+
+    ColecaoSegmentos(const ColecaoSegmentos&) = delete;
+    ColecaoSegmentos& operator=(const ColecaoSegmentos&) = delete;
+
+    /**
+     * @brief Grava históricos residentes como o segmento mais recente.
+     * @param ids Os IDs dos pacotes, em ordem crescente.
+     * @param historicos O histórico de cada pacote de `ids`.
+     * @throws std::runtime_error se o segmento não puder ser gravado.
+     */
+    void despejar(const Lista<int>& ids, const Lista<VisaoHistorico>& historicos);
+
+    /**
+     * @brief Acrescenta a `saida` os eventos de um pacote com timestamp até `tempo`,
+     *        do segmento mais antigo ao mais recente.
+     * @return O número de segmentos que contribuíram com eventos.
+     */
+    int coletarPacote(int idPacote, int tempo, Lista<Evento>& saida) const;
+
+    /**
+     * @brief Atualiza a seleção CL de um pacote com seus eventos nos segmentos.
+     *
+     * Cada segmento é uma parte do histórico, numerada pela sua posição; a parte
+     * residente deve usar o número `getQuantidadeSegmentos()`.
+     */
+    void selecionarParaCliente(int idPacote, int tempo, SelecaoCliente& selecao) const;
+
+    /**
+     * @brief Soma a `contagens` os eventos de cada tipo com timestamp até `tempo`.
+     */
+    void contarEventos(int tempo, long* contagens) const;
+
+    int getQuantidadeSegmentos() const { return segmentos.getTamanho(); }
+    long getQuantidadeEventos() const;
+
+private:
+    std::string diretorio;
+    Lista<SegmentoDisco*> segmentos; ///< Do mais antigo ao mais recente.
+    int proximoArquivo;
+
+    // Mescla em segundo plano. Enquanto `mescla` não é nulo, a thread lê
+    // `segmentos[inicioMescla .. inicioMescla + FATOR_MESCLA)` e grava `resultadoMescla`.
+    std::thread* mescla;
+    std::atomic<bool> mesclaConcluida;
+    SegmentoDisco* origensMescla[FATOR_MESCLA];
+    int inicioMescla;
+    SegmentoDisco* resultadoMescla; ///< `nullptr` se a mescla falhou.
+
+    std::string novoCaminho();
+
+    /**
+     * @brief Substitui os segmentos de origem pelo resultado da mescla, se ela terminou.
+     * @param aguardar Se `true`, espera a mescla em andamento terminar.
+     */
+    void incorporarMescla(bool aguardar);
+
+    /**
+     * @brief Inicia uma mescla de segmentos consecutivos de tamanhos próximos, se houver.
+     */
+    void considerarMescla();
+};
+
+#endif // COLECAO_SEGMENTOS_HPP
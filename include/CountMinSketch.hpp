@@ -0,0 +1,92 @@
+#ifndef COUNT_MIN_SKETCH_HPP
+#define COUNT_MIN_SKETCH_HPP
+
+#include "Lista.hpp"
+#include "Hash.hpp"
+
+/**
+ * @brief Estimador aproximado de frequências (Count-Min Sketch) com memória fixa.
+ *
+ * @details Mantém `profundidade` linhas de `largura` contadores. Cada chave é
+ * mapeada para um contador por linha através de funções de hash independentes,
+ * derivadas de `Hash<Chave>` com uma semente distinta por linha. A estimativa é
+ * o menor dos contadores da chave, que nunca subestima a frequência real.
+ * Utiliza atualização conservadora: apenas os contadores abaixo da nova
+ * estimativa são elevados, o que reduz o erro de superestimação.
+ *
+ * @tparam Chave O tipo da chave. Deve ter uma especialização correspondente em `Hash.hpp`.
+ */
+template <typename Chave>
+class CountMinSketch {
+private:
+    Lista<long> contadores; ///< Matriz `profundidade x largura` armazenada por linhas.
+    int largura;
+    int profundidade;
+
+    /**
+     * @brief Calcula a coluna da chave na linha informada.
+     *
+     * Mistura o hash base com a semente da linha (finalizador do splitmix64)
+     * para obter funções de hash aproximadamente independentes.
+     */
+    int coluna(size_t hashBase, int linha) const {
+        unsigned long long x = static_cast<unsigned long long>(hashBase) +
+                               0x9E3779B97F4A7C15ULL * static_cast<unsigned long long>(linha + 1);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x = x ^ (x >> 31);
+        return static_cast<int>(x % static_cast<unsigned long long>(largura));
+    }
+
+public:
+    /**
+     * @brief Construtor.
+     * @param largura Número de contadores por linha (controla o erro aditivo).
+     * @param profundidade Número de linhas (controla a probabilidade de erro).
+     */
+    CountMinSketch(int largura = 4096, int profundidade = 4)
+        : largura(largura), profundidade(profundidade) {
+        contadores.resize(largura * profundidade);
+    }
+
+    /**
+     * @brief Soma `delta` à frequência da chave.
+     * @param chave A chave observada.
+     * @param delta O incremento (deve ser positivo).
+     * @return A nova estimativa de frequência da chave.
+     */
+    long incrementar(const Chave& chave, long delta = 1) {
+        size_t hashBase = Hash<Chave>{}(chave);
+        long novaEstimativa = estimar(chave) + delta;
+        for (int linha = 0; linha < profundidade; ++linha) {
+            long& contador = contadores[linha * largura + coluna(hashBase, linha)];
+            if (contador < novaEstimativa) {
+                contador = novaEstimativa;
+            }
+        }
+        return novaEstimativa;
+    }
+
+    /**
+     * @brief Estima a frequência da chave.
+     * @param chave A chave consultada.
+     * @return O menor contador associado à chave (limite superior da frequência real).
+     */
+    long estimar(const Chave& chave) const {
+        size_t hashBase = Hash<Chave>{}(chave);
+        long minimo = contadores[coluna(hashBase, 0)];
+        for (int linha = 1; linha < profundidade; ++linha) {
+            long valor = contadores[linha * largura + coluna(hashBase, linha)];
+            if (valor < minimo) {
+                minimo = valor;
+            }
+        }
+        return minimo;
+    }
+
+    UsoMemoria getUsoMemoria() const {
+        return contadores.getUsoMemoria();
+    }
+};
+
+#endif // COUNT_MIN_SKETCH_HPP
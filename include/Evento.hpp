@@ -55,8 +55,10 @@ public:
      *
      * Formata e exibe as informações do evento, ajustando a saída
      * de acordo com o tipo de evento.
+     *
+     * @param saida O fluxo de destino (por padrão, `std::cout`).
      */
-    void imprimir();
+    void imprimir(std::ostream& saida = std::cout) const;
 
     /**
      * @brief Retorna o timestamp do evento.
@@ -0,0 +1,136 @@
+#ifndef EXECUTOR_LOTE_HPP
+#define EXECUTOR_LOTE_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "Lista.hpp"
+#include "MotorLogistico.hpp"
+
+/**
+ * @brief Parâmetros do processamento em lote (`--batch`).
+ */
+struct OpcoesLote {
+    int threads;                ///< Arquivos processados ao mesmo tempo; 0 usa o número de núcleos.
+    long memoriaMaxima;         ///< Memória estimada de todos os arquivos em andamento, em bytes; 0 desativa o limite.
+    std::string diretorioSaida; ///< Onde gravar as saídas; vazio grava cada uma ao lado de sua entrada.
+    long limiteCacheClientes;   ///< Memória do cache de CL de cada arquivo, em bytes; -1 usa o padrão.
+
+    OpcoesLote() : threads(0), memoriaMaxima(0), limiteCacheClientes(-1) {}
+};
+
+/**
+ * @brief Processa vários arquivos de entrada em um único processo, com um conjunto fixo de threads.
+ *
+ * @details Cada arquivo é um `Carregamento` independente, com seu próprio
+ * motor, executado em modo sequencial por uma das threads do conjunto, que
+ * retiram os arquivos de uma fila comum na ordem da lista. As respostas de cada
+ * arquivo vão para um arquivo de saída próprio (`<entrada>.out`, ou
+ * `<diretório>/<nome da entrada>.out`).
+ *
+ * Antes de começar um arquivo, a thread reserva a memória estimada para ele
+ * (`FATOR_MEMORIA` vezes o tamanho da entrada) e espera enquanto a reserva
+ * ultrapassar `OpcoesLote::memoriaMaxima`. Um arquivo maior que o limite
+ * inteiro só começa quando nenhum outro está em andamento, para não travar o lote.
+ *
+ * Ao final, um resumo com a vazão de cada arquivo e a do lote é escrito.
+ */
+class ExecutorLote {
+public:
+    /**
+     * @brief Memória estimada por byte de entrada: as linhas em memória, os eventos e os índices.
+     *
+     * Medido em cerca de 4,4 nas entradas do genwkl3; arredondado para cima.
+     */
+    static const long FATOR_MEMORIA = 5;
+
+    /**
+     * @brief Construtor.
+     * @param arquivos Os arquivos de entrada, na ordem de processamento.
+     * @param opcoesLote Concorrência, memória e destino das saídas.
+     * @param opcoesMotor Parâmetros dos motores de todos os arquivos.
+     */
+    ExecutorLote(const Lista<std::string>& arquivos, const OpcoesLote& opcoesLote,
+                 const OpcoesMotor& opcoesMotor = OpcoesMotor());
+
+    ExecutorLote(const ExecutorLote&) = delete;
+    ExecutorLote& operator=(const ExecutorLote&) = delete;
+
+    /**
+     * @brief Lê um manifesto: um caminho de arquivo por linha; linhas vazias e iniciadas por '#' são ignoradas.
+     * @param caminho O manifesto.
+     * @param arquivos Recebe os caminhos, na ordem do manifesto.
+     * @return `false` se o manifesto não puder ser aberto.
+     */
+    static bool lerManifesto(const std::string& caminho, Lista<std::string>& arquivos);
+
+    /**
+     * @brief Processa todos os arquivos e escreve o resumo de vazão em `resumo`.
+     * @return O número de arquivos que falharam.
+     */
+    int executar(std::ostream& resumo);
+
+private:
+    /**
+     * @brief O resultado do processamento de um arquivo.
+     */
+    struct Resultado {
+        std::string saida; ///< O arquivo de saída.
+        long linhas;
+        long bytes;
+        double ms;         ///< Tempo de parede do arquivo, da leitura à última escrita.
+        int thread;        ///< A thread que processou o arquivo.
+        std::string erro;  ///< Vazio se o arquivo foi processado.
+
+        Resultado() : linhas(0), bytes(0), ms(0), thread(-1) {}
+    };
+
+    Lista<std::string> arquivos;
+    OpcoesLote opcoesLote;
+    OpcoesMotor opcoesMotor;
+    Lista<Resultado> resultados; ///< Um por arquivo; cada posição é escrita por uma única thread.
+
+    // Fila de arquivos e reserva de memória, protegidas por `trava`.
+    std::mutex trava;
+    std::condition_variable memoriaLiberada;
+    int proximoArquivo;
+    long memoriaReservada;
+    int emAndamento;
+
+    /**
+     * @brief Laço de uma thread do conjunto: retira arquivos da fila até esvaziá-la.
+     */
+    void trabalhar(int indiceThread);
+
+    /**
+     * @brief Retira o próximo arquivo da fila e reserva sua memória, esperando se preciso.
+     * @return O índice do arquivo, ou -1 se a fila acabou.
+     */
+    int reservarProximo(long& reserva);
+
+    /**
+     * @brief Devolve a memória reservada para um arquivo concluído.
+     */
+    void liberarReserva(long reserva);
+
+    /**
+     * @brief Processa um arquivo, gravando suas respostas no arquivo de saída.
+     */
+    void processarArquivo(int indice, int indiceThread);
+
+    /**
+     * @brief Retorna o caminho do arquivo de saída de uma entrada.
+     */
+    std::string caminhoSaida(const std::string& entrada) const;
+
+    /**
+     * @brief Escreve o resumo em CSV: uma linha por arquivo e a linha "total" do lote.
+     */
+    void escreverResumo(std::ostream& resumo, int numThreads, double msTotal) const;
+
+    static void escreverLinhaResumo(std::ostream& resumo, const std::string& arquivo, const std::string& saida,
+                                    int thread, long linhas, long bytes, double ms, const std::string& estado);
+};
+
+#endif // EXECUTOR_LOTE_HPP
@@ -0,0 +1,149 @@
+#ifndef EXECUTOR_PARTICIONADO_HPP
+#define EXECUTOR_PARTICIONADO_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "Lista.hpp"
+#include "FilaSPSC.hpp"
+#include "MotorLogistico.hpp"
+#include "AnalisadorLinha.hpp"
+
+/**
+ * @brief Execução em várias threads, com os pacotes particionados entre motores independentes.
+ *
+ * @details Cada partição é um `MotorLogistico` com sua própria thread e recebe,
+ * por uma `FilaSPSC`, os eventos dos pacotes cujo `particaoDoPacote` é o seu
+ * índice. Como todos os eventos de um pacote caem na mesma partição, as
+ * consultas PC e RT são respondidas por uma única partição; CL, LA e CE são
+ * difundidas a todas e os resultados parciais são combinados (intercalação
+ * ordenada, mescla das estatísticas e soma das contagens). Os rankings RK são
+ * globais e mantidos pela thread coordenadora, que lê os comandos em ordem.
+ *
+ * Uma thread escritora recebe as consultas na ordem da entrada e espera cada uma
+ * ser concluída por todas as partições envolvidas antes de escrevê-la, então a
+ * saída é idêntica à da execução sequencial.
+ */
+class ExecutorParticionado {
+public:
+    /**
+     * @brief Construtor.
+     * @param numParticoes O número de partições (e de threads de execução).
+     * @param opcoes Parâmetros dos motores; os rankings ficam com o coordenador.
+     */
+    ExecutorParticionado(int numParticoes, const OpcoesMotor& opcoes = OpcoesMotor());
+    ~ExecutorParticionado();
+
+    ExecutorParticionado(const ExecutorParticionado&) = delete;
+    ExecutorParticionado& operator=(const ExecutorParticionado&) = delete;
+
+    /**
+     * @brief Processa as linhas de entrada, escrevendo as respostas em `saida`.
+     * @param linhas As linhas de entrada, na ordem do arquivo.
+     * @param saida O fluxo onde as respostas de consultas são escritas.
+     */
+    void executar(const Lista<std::string>& linhas, std::ostream& saida);
+
+    /**
+     * @brief Registra a memória das partições, somada por estrutura, e a dos rankings globais.
+     *
+     * Só pode ser chamado fora de `executar`, com as threads das partições paradas.
+     */
+    void medirMemoria(RelatorioMemoria& relatorio) const;
+
+private:
+    /**
+     * @brief A parte de uma consulta calculada por uma partição.
+     */
+    struct ResultadoParcial {
+        Lista<Evento> eventos;          ///< PC e CL.
+        Lista<ParadaRota> paradas;      ///< RT.
+        EstatisticasTrecho trecho;      ///< LA.
+        bool trechoEncontrado;          ///< LA: se a partição concluiu algum trânsito no trecho.
+        long contagens[INDEFINIDO + 1]; ///< CE.
+
+        ResultadoParcial() : trechoEncontrado(false) {}
+    };
+
+    /**
+     * @brief Uma consulta em andamento, compartilhada pelas partições e pela escritora.
+     *
+     * Cada partição grava apenas o próprio resultado parcial e então decrementa
+     * `pendentes`; a escritora só lê os resultados depois que o contador zera.
+     * A partição que zera o contador acorda a escritora por `respostaPronta`.
+     */
+    struct ConsultaDistribuida {
+        Comando comando;
+        std::atomic<int> pendentes;   ///< Partições que ainda não responderam.
+        int particaoUnica;            ///< A partição responsável, ou -1 se difundida a todas.
+        ResultadoParcial* parciais;   ///< Um resultado por partição (ou um só, se `particaoUnica >= 0`).
+        std::string texto;            ///< Resposta já formatada (RK), quando não há partições envolvidas.
+
+        ConsultaDistribuida() : pendentes(0), particaoUnica(-1), parciais(nullptr) {}
+        ~ConsultaDistribuida() { delete[] parciais; }
+    };
+
+    /**
+     * @brief Um item do lote enviado a uma partição: um evento ou uma consulta.
+     */
+    struct Tarefa {
+        Evento evento;
+        ConsultaDistribuida* consulta; ///< `nullptr` se a tarefa for a ingestão de `evento`.
+
+        Tarefa() : consulta(nullptr) {}
+    };
+
+    struct Particao {
+        MotorLogistico* motor;
+        FilaSPSC<Lista<Tarefa>*>* fila;
+        Lista<Tarefa>* lote; ///< Lote em montagem pelo coordenador.
+    };
+
+    int numParticoes;
+    Particao* particoes;
+    RankingsAtividade rankings;                     ///< Rankings globais, mantidos pelo coordenador.
+    FilaSPSC<ConsultaDistribuida*> filaConsultas;   ///< Consultas na ordem da entrada, para a escritora.
+    std::mutex mutexRespostas;                      ///< Protege a espera da escritora por `respostaPronta`.
+    std::condition_variable respostaPronta;         ///< Sinalizada quando uma consulta recebe sua última parte.
+
+    /**
+     * @brief Retorna a partição de um pacote; IDs negativos, aceitos pelo interpretador, também caem em `[0, numParticoes)`.
+     */
+    int particaoDoPacote(int idPacote) const {
+        return static_cast<int>(static_cast<unsigned>(idPacote) % static_cast<unsigned>(numParticoes));
+    }
+
+    /**
+     * @brief Acrescenta uma tarefa ao lote de uma partição, enviando-o quando cheio.
+     */
+    void enviarTarefa(int indice, const Tarefa& tarefa);
+
+    /**
+     * @brief Envia às partições os lotes parcialmente preenchidos.
+     */
+    void esvaziarLotes();
+
+    /**
+     * @brief Laço de uma partição: ingere eventos e responde à sua parte das consultas.
+     */
+    void executarParticao(int indice);
+
+    /**
+     * @brief Calcula a parte de uma consulta que cabe à partição `indice`.
+     */
+    void responderConsulta(int indice, ConsultaDistribuida* consulta);
+
+    /**
+     * @brief Laço da escritora: combina os resultados parciais e escreve as respostas em ordem.
+     */
+    void escreverRespostas(std::ostream& saida);
+
+    /**
+     * @brief Combina os resultados parciais de uma consulta e escreve sua resposta.
+     */
+    void escreverResposta(const ConsultaDistribuida* consulta, std::ostream& saida);
+};
+
+#endif // EXECUTOR_PARTICIONADO_HPP
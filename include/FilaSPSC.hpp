@@ -0,0 +1,140 @@
+#ifndef FILA_SPSC_HPP
+#define FILA_SPSC_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+/**
+ * @brief Espera por outra thread: cede a CPU algumas vezes e depois dorme em intervalos crescentes.
+ *
+ * @details Ceder sem dormir mantém a thread que espera sempre pronta para
+ * executar; com menos núcleos livres que threads, ela disputa a CPU com as que
+ * produzem o que ela espera. As primeiras esperas só cedem, para que uma
+ * resposta que chega logo não pague a latência de um `sleep`.
+ */
+class EsperaAdaptativa {
+public:
+    static const int CESSOES = 16;              ///< Esperas que só cedem a CPU antes de dormir.
+    static const int MAXIMO_MICROSSEGUNDOS = 64; ///< Maior intervalo de sono.
+
+    EsperaAdaptativa() : esperas(0) {}
+
+    /**
+     * @brief Aguarda um pouco antes da próxima verificação da condição.
+     */
+    void esperar() {
+        if (esperas < CESSOES) {
+            std::this_thread::yield();
+        } else {
+            int expoente = esperas - CESSOES;
+            int micro = expoente < 6 ? 1 << expoente : MAXIMO_MICROSSEGUNDOS;
+            std::this_thread::sleep_for(std::chrono::microseconds(micro));
+        }
+        esperas++;
+    }
+
+private:
+    int esperas;
+};
+
+/**
+ * @brief Fila circular limitada, sem travas, para um produtor e um consumidor.
+ *
+ * @details Cada lado avança apenas o próprio índice (`cauda` pelo produtor,
+ * `cabeca` pelo consumidor) e lê o do outro com semântica acquire/release, o
+ * que basta para sincronizar os elementos sem mutex. Os índices crescem
+ * indefinidamente e são reduzidos à capacidade (potência de dois) por máscara.
+ * Os dois índices são separados por preenchimento de uma linha de cache, para
+ * evitar falso compartilhamento entre as threads sem exigir alocação alinhada
+ * (que o `new` do C++11 não garante quando a fila é alocada dinamicamente).
+ *
+ * @tparam T O tipo dos elementos; tipicamente um ponteiro para um lote.
+ */
+template <typename T>
+class FilaSPSC {
+private:
+    static const size_t LINHA_CACHE = 64;
+
+    T* buffer;
+    size_t mascara;
+    char preenchimentoInicial[LINHA_CACHE];
+    std::atomic<size_t> cabeca; ///< Próxima posição a ser lida (consumidor).
+    char preenchimentoCabeca[LINHA_CACHE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> cauda;  ///< Próxima posição a ser escrita (produtor).
+    char preenchimentoCauda[LINHA_CACHE - sizeof(std::atomic<size_t>)];
+
+public:
+    /**
+     * @brief Construtor.
+     * @param capacidadeMinima A capacidade desejada, arredondada para a próxima potência de dois.
+     */
+    explicit FilaSPSC(size_t capacidadeMinima) : cabeca(0), cauda(0) {
+        size_t capacidade = 1;
+        while (capacidade < capacidadeMinima) {
+            capacidade <<= 1;
+        }
+        buffer = new T[capacidade];
+        mascara = capacidade - 1;
+    }
+
+    ~FilaSPSC() {
+        delete[] buffer;
+    }
+
+    FilaSPSC(const FilaSPSC&) = delete;
+    FilaSPSC& operator=(const FilaSPSC&) = delete;
+
+    /**
+     * @brief Tenta inserir um elemento. Deve ser chamado apenas pelo produtor.
+     * @return `false` se a fila estiver cheia.
+     */
+    bool tentarInserir(const T& valor) {
+        size_t posicao = cauda.load(std::memory_order_relaxed);
+        if (posicao - cabeca.load(std::memory_order_acquire) > mascara) {
+            return false;
+        }
+        buffer[posicao & mascara] = valor;
+        cauda.store(posicao + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Tenta remover um elemento. Deve ser chamado apenas pelo consumidor.
+     * @return `false` se a fila estiver vazia.
+     */
+    bool tentarRemover(T& valor) {
+        size_t posicao = cabeca.load(std::memory_order_relaxed);
+        if (posicao == cauda.load(std::memory_order_acquire)) {
+            return false;
+        }
+        valor = buffer[posicao & mascara];
+        cabeca.store(posicao + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Insere um elemento, esperando com `EsperaAdaptativa` enquanto a fila estiver cheia.
+     */
+    void inserir(const T& valor) {
+        EsperaAdaptativa espera;
+        while (!tentarInserir(valor)) {
+            espera.esperar();
+        }
+    }
+
+    /**
+     * @brief Remove um elemento, esperando com `EsperaAdaptativa` enquanto a fila estiver vazia.
+     */
+    T remover() {
+        T valor;
+        EsperaAdaptativa espera;
+        while (!tentarRemover(valor)) {
+            espera.esperar();
+        }
+        return valor;
+    }
+};
+
+#endif // FILA_SPSC_HPP
@@ -0,0 +1,77 @@
+#ifndef FORMATADOR_SAIDA_HPP
+#define FORMATADOR_SAIDA_HPP
+
+#include <ostream>
+#include <string>
+#include "Evento.hpp"
+#include "Lista.hpp"
+#include "IndiceRotas.hpp"
+#include "RankingsAtividade.hpp"
+#include "IndiceAssinaturas.hpp"
+
+/**
+ * @brief Escrita das respostas das consultas no formato texto de saída.
+ *
+ * Separa a formatação do cálculo dos resultados, para que execuções sequenciais
+ * e particionadas produzam exatamente o mesmo texto a partir dos mesmos resultados.
+ */
+class FormatadorSaida {
+public:
+    /**
+     * @brief Escreve a resposta de uma consulta PC.
+     */
+    static void escreverPacote(int tempo, int idPacote, const Lista<Evento>& eventos, std::ostream& saida);
+
+    /**
+     * @brief Escreve a resposta de uma consulta CL.
+     */
+    static void escreverCliente(int tempo, const std::string& nomeCliente, const Lista<Evento>& eventos, std::ostream& saida);
+
+    /**
+     * @brief Escreve o cabeçalho da resposta de uma consulta CL.
+     */
+    static void escreverCabecalhoCliente(int tempo, const std::string& nomeCliente, std::ostream& saida);
+
+    /**
+     * @brief Escreve o corpo de uma resposta PC ou CL: a contagem e os eventos.
+     */
+    static void escreverEventos(const Lista<Evento>& eventos, std::ostream& saida);
+
+    /**
+     * @brief Escreve o cabeçalho de uma linha de assinatura: "TTTTTT OP CL nome" ou "TTTTTT OP PC NNN".
+     * @param operacao "AS" (assinatura), "CA" (cancelamento) ou "NT" (notificação).
+     */
+    static void escreverCabecalhoAssinatura(int tempo, const char* operacao, TipoAssinatura tipo,
+                                            const std::string& nomeCliente, int idPacote, std::ostream& saida);
+
+    /**
+     * @brief Escreve uma notificação de assinatura: o cabeçalho NT, no instante do evento, e os eventos novos.
+     */
+    static void escreverNotificacao(const Notificacao& notificacao, std::ostream& saida);
+
+    /**
+     * @brief Escreve a resposta de uma consulta RK.
+     * @param rankings Os rankings consultados; se `nullptr`, a resposta é vazia.
+     */
+    static void escreverRanking(int tempo, const std::string& categoria, int quantidade,
+                                const RankingsAtividade* rankings, std::ostream& saida);
+
+    /**
+     * @brief Escreve a resposta de uma consulta RT.
+     */
+    static void escreverRota(int tempo, int idPacote, const Lista<ParadaRota>& paradas, std::ostream& saida);
+
+    /**
+     * @brief Escreve a resposta de uma consulta LA.
+     * @param resumo As estatísticas do trecho, ou `nullptr` se nenhum trânsito foi concluído nele.
+     */
+    static void escreverTrecho(int tempo, int origem, int destino, const ResumoTrecho* resumo, std::ostream& saida);
+
+    /**
+     * @brief Escreve a resposta de uma consulta CE.
+     * @param contagens Array com uma posição por `TipoEvento`.
+     */
+    static void escreverContagem(int tempo, const long* contagens, std::ostream& saida);
+};
+
+#endif // FORMATADOR_SAIDA_HPP
@@ -30,6 +30,23 @@ struct Hash<int> {
     }
 };
 
+/**
+ * @brief Especialização do Hash para chaves do tipo `long long`.
+ */
+template <>
+struct Hash<long long> {
+    /**
+     * @brief Calcula o hash para uma chave `long long`.
+     * @param key A chave inteira.
+     * @return A chave com a metade alta espalhada sobre a baixa, para que as duas
+     *         metades decidam o balde mesmo com um número de baldes potência de 2.
+     */
+    size_t operator()(long long key) const {
+        unsigned long long valor = static_cast<unsigned long long>(key);
+        return static_cast<size_t>(valor ^ ((valor >> 32) * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
 /**
  * @brief Especialização do Hash para chaves do tipo `std::string`.
  */
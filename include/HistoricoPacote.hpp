@@ -0,0 +1,231 @@
+#ifndef HISTORICO_PACOTE_HPP
+#define HISTORICO_PACOTE_HPP
+
+#include <cstddef>
+#include <stdint.h>
+#include "Evento.hpp"
+#include "Lista.hpp"
+
+/**
+ * @brief Entrada do índice de saltos de um histórico codificado.
+ */
+struct MarcadorHistorico {
+    int32_t deslocamento; ///< Posição do primeiro byte do bloco.
+    int32_t tempoInicial; ///< Timestamp do primeiro evento do bloco.
+};
+
+/**
+ * @brief Os eventos de um pacote que entram na resposta de uma consulta CL.
+ *
+ * @details O histórico de um pacote pode estar dividido em partes (segmentos em
+ * disco e memória), visitadas da mais antiga para a mais recente. Cada parte
+ * atualiza a seleção com os mesmos critérios que seriam aplicados ao histórico
+ * inteiro; `parte` e `indice` identificam os eventos escolhidos, para que o
+ * registro e o último evento não sejam emitidos duas vezes.
+ */
+struct SelecaoCliente {
+    Evento registro;  ///< O último RG até o instante da consulta.
+    Evento ultimo;    ///< O último evento até o instante, com desempate pelo maior tipo.
+    bool temRegistro;
+    bool temUltimo;
+    int parteRegistro;
+    int indiceRegistro;
+    int parteUltimo;
+    int indiceUltimo;
+
+    SelecaoCliente() : temRegistro(false), temUltimo(false), parteRegistro(-1), indiceRegistro(-1),
+                       parteUltimo(-1), indiceUltimo(-1) {}
+
+    /**
+     * @brief Indica se o registro e o último evento são o mesmo evento.
+     */
+    bool mesmoEvento() const {
+        return temRegistro && temUltimo && parteRegistro == parteUltimo && indiceRegistro == indiceUltimo;
+    }
+};
+
+/**
+ * @brief Leitura de um histórico de pacote codificado, em memória ou mapeado de um arquivo.
+ *
+ * @details Os eventos ficam em ordem de tempo (e de ingestão, nos empates). Cada
+ * evento ocupa:
+ *  - o intervalo desde o evento anterior, em varint (1 byte na maioria dos casos);
+ *  - um byte de cabeçalho com o tipo (3 bits), a presença de armazém de origem,
+ *    armazém de destino e seção (3 bits) e o formato dos campos (1 bit);
+ *  - os campos presentes: dois por byte quando todos cabem em 4 bits, ou em
+ *    varint (zigzag) caso contrário;
+ *  - em um RG, remetente e destinatário, cada um precedido do comprimento.
+ *
+ * A cada `PASSO_MARCADORES` eventos, um `MarcadorHistorico` guarda onde o bloco
+ * começa e seu primeiro timestamp. PC decodifica apenas o prefixo até o instante
+ * da consulta; CL localiza por busca binária nos marcadores o bloco do último
+ * evento e decodifica só ele.
+ *
+ * A visão não é dona da memória que referencia.
+ */
+class VisaoHistorico {
+public:
+    static const int PASSO_MARCADORES = 16; ///< Eventos por bloco do índice de saltos.
+
+    /**
+     * @brief Constrói uma visão vazia.
+     */
+    VisaoHistorico() : bytes(nullptr), tamanho(0), marcadores(nullptr), quantidade(0), registros(0) {}
+
+    /**
+     * @brief Constrói uma visão sobre um histórico codificado.
+     * @param bytes Os eventos codificados.
+     * @param tamanho O número de bytes.
+     * @param marcadores Os marcadores dos blocos a partir do segundo (`quantidadeMarcadores(quantidade)` entradas).
+     * @param quantidade O número de eventos.
+     * @param registros O número de eventos RG.
+     */
+    VisaoHistorico(const unsigned char* bytes, size_t tamanho, const MarcadorHistorico* marcadores,
+                   int quantidade, int registros)
+        : bytes(bytes), tamanho(tamanho), marcadores(marcadores), quantidade(quantidade), registros(registros) {}
+
+    /**
+     * @brief Número de marcadores de um histórico com `quantidade` eventos.
+     *
+     * O primeiro bloco começa sempre no byte 0 e não tem marcador.
+     */
+    static int quantidadeMarcadores(int quantidade) {
+        return quantidade > 0 ? (quantidade - 1) / PASSO_MARCADORES : 0;
+    }
+
+    /**
+     * @brief Acrescenta a `saida` os eventos com timestamp até `tempo`, em ordem.
+     * @param tempo O timestamp máximo.
+     * @param idPacote O ID gravado nos eventos reconstruídos.
+     * @param saida A lista de destino.
+     * @return O número de eventos acrescentados.
+     */
+    int decodificarAte(int tempo, int idPacote, Lista<Evento>& saida) const;
+
+    /**
+     * @brief Acrescenta a `saida` todos os eventos a partir do bloco do último evento com timestamp até `tempo`.
+     * @param tempo O timestamp procurado.
+     * @param idPacote O ID gravado nos eventos reconstruídos.
+     * @param saida A lista de destino.
+     * @param tempoAnterior Recebe o timestamp do evento que precede o bloco, ou 0 no primeiro bloco.
+     * @return O índice do bloco.
+     */
+    int decodificarDesdeBloco(int tempo, int idPacote, Lista<Evento>& saida, int& tempoAnterior) const;
+
+    /**
+     * @brief Soma a `contagens` os eventos de cada tipo com timestamp maior que `tempo`.
+     *
+     * Decodifica só a partir do bloco que contém `tempo`, de modo que o custo
+     * depende do número de eventos posteriores, não do tamanho do histórico.
+     *
+     * @param tempo O timestamp da consulta.
+     * @param contagens Array com uma posição por `TipoEvento` (incluindo INDEFINIDO).
+     */
+    void contarPosteriores(int tempo, long* contagens) const;
+
+    /**
+     * @brief Atualiza a seleção CL com o registro e o último evento desta parte até `tempo`.
+     * @param tempo O timestamp da consulta.
+     * @param idPacote O ID gravado nos eventos reconstruídos.
+     * @param parte A posição desta parte entre as partes do histórico, em ordem crescente.
+     * @param selecao A seleção acumulada das partes anteriores.
+     */
+    void selecionarParaCliente(int tempo, int idPacote, int parte, SelecaoCliente& selecao) const;
+
+    int getQuantidade() const { return quantidade; }
+    int getRegistros() const { return registros; }
+    size_t getTamanhoBytes() const { return tamanho; }
+    const unsigned char* getBytes() const { return bytes; }
+    const MarcadorHistorico* getMarcadores() const { return marcadores; }
+
+private:
+    /**
+     * @brief Posição de leitura dentro do histórico.
+     */
+    struct Leitor {
+        const unsigned char* p;
+        int tempo;  ///< Timestamp do evento anterior.
+        int indice; ///< Índice do próximo evento.
+    };
+
+    const unsigned char* bytes;
+    size_t tamanho;
+    const MarcadorHistorico* marcadores;
+    int quantidade;
+    int registros;
+
+    /**
+     * @brief Posiciona um leitor no início de um bloco.
+     */
+    Leitor inicioBloco(int bloco) const;
+
+    /**
+     * @brief Retorna o último bloco cujo primeiro timestamp é menor (ou, se `inclusivo`, até) `tempo`.
+     */
+    int buscarBloco(int tempo, bool inclusivo) const;
+
+    /**
+     * @brief Decodifica o próximo evento e avança o leitor.
+     */
+    static void ler(Leitor& leitor, int idPacote, Evento& ev);
+};
+
+/**
+ * @brief Histórico codificado de um pacote, mantido em memória e estendido a cada evento.
+ *
+ * @details Usa o formato descrito em `VisaoHistorico`, que também é o formato
+ * gravado nos segmentos em disco, de modo que um despejo copia os bytes sem
+ * recodificá-los. Eventos em ordem de tempo são acrescentados ao final; um
+ * evento atrasado recodifica o histórico a partir do bloco em que entra, de
+ * modo que o custo depende do atraso, não do tamanho do histórico.
+ */
+class HistoricoPacote {
+public:
+    HistoricoPacote() : quantidade(0), ultimoTempo(0), registros(0) {}
+
+    /**
+     * @brief Acrescenta um evento, após os de timestamp menor ou igual.
+     */
+    void adicionar(const Evento& ev);
+
+    /**
+     * @brief Retorna uma visão de leitura, válida até a próxima modificação.
+     */
+    VisaoHistorico visao() const {
+        return VisaoHistorico(bytes.dados(), static_cast<size_t>(bytes.getTamanho()), marcadores.dados(),
+                              quantidade, registros);
+    }
+
+    /**
+     * @brief Descarta todos os eventos e libera a memória.
+     */
+    void limpar();
+
+    /**
+     * @brief Troca o conteúdo deste histórico com o de outro em O(1).
+     */
+    void trocar(HistoricoPacote& outro);
+
+    int getQuantidade() const { return quantidade; }
+    int getUltimoTempo() const { return ultimoTempo; }
+
+    UsoMemoria getUsoMemoria() const {
+        UsoMemoria uso = bytes.getUsoMemoria();
+        uso += marcadores.getUsoMemoria();
+        return uso;
+    }
+
+private:
+    Lista<unsigned char> bytes;
+    Lista<MarcadorHistorico> marcadores;
+    int quantidade;
+    int ultimoTempo; ///< Timestamp do último evento, o maior do histórico.
+    int registros;
+
+    /**
+     * @brief Codifica um evento ao final; seu timestamp não pode ser menor que `ultimoTempo`.
+     */
+    void acrescentar(const Evento& ev);
+};
+
+#endif // HISTORICO_PACOTE_HPP
@@ -0,0 +1,168 @@
+#ifndef INDICE_ASSINATURAS_HPP
+#define INDICE_ASSINATURAS_HPP
+
+#include <string>
+#include "Evento.hpp"
+#include "Lista.hpp"
+#include "Mapa.hpp"
+#include "HistoricoPacote.hpp"
+
+/**
+ * @brief O alvo de uma assinatura: a resposta de CL de um cliente ou a de PC de um pacote.
+ */
+enum TipoAssinatura {
+    ASSINATURA_CLIENTE, // CL
+    ASSINATURA_PACOTE   // PC
+};
+
+/**
+ * @brief A mudança na resposta de uma consulta assinada causada pela ingestão de um evento.
+ *
+ * Para PC, `eventos` traz o evento novo do pacote. Para CL, traz o novo RG ou o
+ * novo último evento de um pacote do cliente; quando um RG passa a associar um
+ * pacote ao cliente, traz o RG e o último evento do pacote, como na resposta de CL.
+ */
+struct Notificacao {
+    TipoAssinatura tipo;
+    int tempo;               ///< Timestamp do evento que causou a mudança.
+    std::string nomeCliente; ///< O cliente assinado (CL).
+    int idPacote;            ///< O pacote assinado (PC) ou o pacote alterado (CL).
+    Lista<Evento> eventos;   ///< Os eventos que entram na resposta, em ordem de tempo.
+
+    Notificacao() : tipo(ASSINATURA_PACOTE), tempo(0), idPacote(-1) {}
+};
+
+/**
+ * @brief Consultas CL e PC permanentes, atualizadas incrementalmente a cada evento.
+ *
+ * @details Um índice reverso associa cada pacote observado aos seus assinantes:
+ * a assinatura PC do próprio pacote e as assinaturas CL dos clientes que o
+ * enviam ou recebem. O índice guarda também o RG e o último evento (com
+ * desempate pelo maior tipo) de cada pacote observado, o que basta para decidir
+ * se um evento novo altera a resposta de CL. Assim, o custo das notificações é
+ * uma busca no índice por evento ingerido, mais as notificações emitidas,
+ * independentemente de quantas vezes as respostas são lidas.
+ *
+ * As respostas acompanhadas são as de um instante posterior a todos os eventos
+ * ingeridos; eventos atrasados que não superam o último evento de um pacote
+ * alteram apenas a resposta de PC.
+ */
+class IndiceAssinaturas {
+public:
+    IndiceAssinaturas();
+    ~IndiceAssinaturas();
+
+    IndiceAssinaturas(const IndiceAssinaturas&) = delete;
+    IndiceAssinaturas& operator=(const IndiceAssinaturas&) = delete;
+
+    /**
+     * @brief Registra a assinatura CL de um cliente.
+     * @return `false` se o cliente já estava assinado.
+     */
+    bool assinarCliente(const std::string& nomeCliente);
+
+    /**
+     * @brief Registra a assinatura PC de um pacote.
+     * @param estado O RG e o último evento atuais do pacote.
+     * @return `false` se o pacote já estava assinado.
+     */
+    bool assinarPacote(int idPacote, const SelecaoCliente& estado);
+
+    /**
+     * @brief Remove a assinatura CL de um cliente.
+     * @return `false` se o cliente não estava assinado.
+     */
+    bool cancelarCliente(const std::string& nomeCliente);
+
+    /**
+     * @brief Remove a assinatura PC de um pacote.
+     * @return `false` se o pacote não estava assinado.
+     */
+    bool cancelarPacote(int idPacote);
+
+    /**
+     * @brief Indica se o cliente tem assinatura CL.
+     */
+    bool clienteAssinado(const std::string& nomeCliente) const;
+
+    /**
+     * @brief Indica se o pacote já é observado em nome da assinatura CL do cliente.
+     */
+    bool clienteObservaPacote(const std::string& nomeCliente, int idPacote) const;
+
+    /**
+     * @brief Passa a observar um pacote em nome da assinatura CL de um cliente.
+     * @param estado O RG e o último evento atuais do pacote; ignorado se o pacote já era observado.
+     */
+    void vincularPacote(const std::string& nomeCliente, int idPacote, const SelecaoCliente& estado);
+
+    /**
+     * @brief Atualiza o estado do pacote do evento e enfileira as notificações dos seus assinantes.
+     *
+     * Deve ser chamado depois de o evento entrar no histórico do pacote e antes
+     * de um RG vincular o pacote a novos clientes.
+     */
+    void registrarEvento(const Evento& ev);
+
+    /**
+     * @brief Enfileira a notificação de um pacote recém-vinculado à assinatura CL de um cliente.
+     */
+    void notificarVinculo(const std::string& nomeCliente, const Evento& ev, const SelecaoCliente& estado);
+
+    /**
+     * @brief Move as notificações pendentes, em ordem de emissão, para o fim de `saida`.
+     * @return O número de notificações movidas.
+     */
+    int coletarNotificacoes(Lista<Notificacao>& saida);
+
+    /**
+     * @brief Indica se há notificações pendentes.
+     */
+    bool temNotificacoes() const { return pendentes.getTamanho() > 0; }
+
+    /**
+     * @brief Retorna o número de pacotes no índice reverso.
+     */
+    size_t getPacotesObservados() const { return pacotes.getTamanho(); }
+
+    /**
+     * @brief Retorna a memória das assinaturas, do índice reverso e das notificações pendentes.
+     */
+    UsoMemoria getUsoMemoria() const;
+
+private:
+    /**
+     * @brief Uma assinatura CL e os pacotes observados em seu nome.
+     */
+    struct AssinaturaCliente {
+        std::string nomeCliente;
+        Lista<int> pacotes;
+    };
+
+    /**
+     * @brief Entrada do índice reverso: os assinantes de um pacote e o estado da sua resposta de CL.
+     */
+    struct AssinantesPacote {
+        bool assinaturaPacote;                  ///< Se o próprio pacote tem assinatura PC.
+        Lista<AssinaturaCliente*, 2> clientes;  ///< Remetente e destinatário assinados, sem alocação.
+        SelecaoCliente estado;                  ///< O RG e o último evento do pacote.
+
+        AssinantesPacote() : assinaturaPacote(false) {}
+    };
+
+    Mapa<std::string, AssinaturaCliente*> clientes;
+    Mapa<int, AssinantesPacote*> pacotes; ///< O índice reverso.
+    Lista<Notificacao> pendentes;
+
+    /**
+     * @brief Retorna a entrada de um pacote, criando-a com `estado` se ainda não existir.
+     */
+    AssinantesPacote* obterPacote(int idPacote, const SelecaoCliente& estado);
+
+    /**
+     * @brief Remove a entrada de um pacote que ficou sem assinantes.
+     */
+    void liberarSeVazio(int idPacote, AssinantesPacote* assinantes);
+};
+
+#endif // INDICE_ASSINATURAS_HPP
@@ -0,0 +1,168 @@
+#ifndef INDICE_ROTAS_HPP
+#define INDICE_ROTAS_HPP
+
+#include "Evento.hpp"
+#include "Lista.hpp"
+#include "Mapa.hpp"
+#include "SketchQuantis.hpp"
+
+/**
+ * @brief Uma parada na rota de um pacote: o armazém e o instante de chegada.
+ */
+struct ParadaRota {
+    int armazem;
+    int chegada;
+};
+
+/**
+ * @brief Rota comprimida de um pacote.
+ *
+ * Guarda apenas os armazéns distintos consecutivos por onde o pacote passou,
+ * além do trânsito em andamento, usado para medir o tempo de cada trecho.
+ */
+struct RotaPacote {
+    Lista<ParadaRota> paradas; ///< Armazéns visitados, em ordem de chegada.
+    int origemTransito;        ///< Armazém de partida do trânsito em andamento (-1 se nenhum).
+    int destinoTransito;       ///< Armazém de chegada do trânsito em andamento.
+    int inicioTransito;        ///< Instante do evento TR que iniciou o trânsito.
+
+    RotaPacote() : origemTransito(-1), destinoTransito(-1), inicioTransito(0) {}
+};
+
+/**
+ * @brief Resumo das estatísticas de latência de um trecho entre armazéns.
+ */
+struct ResumoTrecho {
+    long contagem;  ///< Número de trânsitos concluídos no trecho.
+    int minimo;
+    int maximo;
+    double media;
+    double p50;
+    double p90;
+    double p99;
+};
+
+/**
+ * @brief Estatísticas de latência de um trecho (par de armazéns origem-destino).
+ */
+struct EstatisticasTrecho {
+    long contagem;         ///< Número de trânsitos concluídos no trecho.
+    int minimo;            ///< Menor tempo de trânsito observado.
+    int maximo;            ///< Maior tempo de trânsito observado.
+    long soma;             ///< Soma dos tempos de trânsito, para o cálculo da média.
+    SketchQuantis quantis; ///< Estimador dos percentis de tempo de trânsito.
+
+    EstatisticasTrecho() : contagem(0), minimo(0), maximo(0), soma(0) {}
+
+    /**
+     * @brief Retorna o tempo médio de trânsito no trecho.
+     */
+    double media() const {
+        return contagem == 0 ? 0.0 : static_cast<double>(soma) / contagem;
+    }
+
+    /**
+     * @brief Acumula as estatísticas de outro conjunto de trânsitos do mesmo trecho.
+     * @param outras Estatísticas parciais, e.g., calculadas em outra partição.
+     */
+    void mesclar(const EstatisticasTrecho& outras) {
+        if (outras.contagem == 0) {
+            return;
+        }
+        if (contagem == 0 || outras.minimo < minimo) minimo = outras.minimo;
+        if (contagem == 0 || outras.maximo > maximo) maximo = outras.maximo;
+        contagem += outras.contagem;
+        soma += outras.soma;
+        quantis.mesclar(outras.quantis);
+    }
+
+    /**
+     * @brief Calcula o resumo exposto pela consulta LA.
+     */
+    ResumoTrecho resumo() const {
+        ResumoTrecho r;
+        r.contagem = contagem;
+        r.minimo = minimo;
+        r.maximo = maximo;
+        r.media = media();
+        r.p50 = quantis.quantil(0.50);
+        r.p90 = quantis.quantil(0.90);
+        r.p99 = quantis.quantil(0.99);
+        return r;
+    }
+};
+
+/**
+ * @brief Índice de rotas de pacotes e de latência dos trechos entre armazéns.
+ *
+ * @details Mantido incrementalmente a cada evento ingerido. Um evento TR abre um
+ * trânsito do pacote entre dois armazéns; o próximo AR do pacote o encerra,
+ * e a diferença de tempo alimenta as estatísticas do trecho. As chegadas (AR) e
+ * a origem do registro (RG) formam a rota comprimida do pacote. Consultas de rota
+ * e de trecho são respondidas sem revarrer os eventos.
+ */
+class IndiceRotas {
+public:
+    IndiceRotas();
+    ~IndiceRotas();
+
+    IndiceRotas(const IndiceRotas&) = delete;
+    IndiceRotas& operator=(const IndiceRotas&) = delete;
+
+    /**
+     * @brief Atualiza as rotas e os trechos com um novo evento.
+     * @param ev O evento ingerido.
+     */
+    void registrarEvento(const Evento& ev);
+
+    /**
+     * @brief Busca a rota de um pacote.
+     * @param idPacote O ID do pacote.
+     * @return A rota do pacote, ou `nullptr` se ele não tiver eventos.
+     */
+    const RotaPacote* obterRota(int idPacote) const;
+
+    /**
+     * @brief Descarta a rota de um pacote, liberando sua memória.
+     *
+     * As estatísticas dos trechos já percorridos pelo pacote são mantidas.
+     *
+     * @param idPacote O ID do pacote.
+     */
+    void removerRota(int idPacote);
+
+    /**
+     * @brief Busca as estatísticas de um trecho.
+     * @param origem O armazém de partida.
+     * @param destino O armazém de chegada.
+     * @return As estatísticas do trecho, ou `nullptr` se nenhum trânsito foi concluído nele.
+     */
+    const EstatisticasTrecho* obterTrecho(int origem, int destino) const;
+
+    /**
+     * @brief Retorna o número de pacotes com rota.
+     */
+    size_t getQuantidadeRotas() const { return rotas->getTamanho(); }
+
+    /**
+     * @brief Retorna a memória das rotas e das estatísticas dos trechos.
+     */
+    UsoMemoria getUsoMemoria() const;
+
+private:
+    Mapa<int, RotaPacote*>* rotas;           ///< Mapeia ID do pacote para sua rota.
+    Mapa<long long, EstatisticasTrecho*>* trechos; ///< Mapeia o par (origem, destino) para suas estatísticas.
+    Lista<EstatisticasTrecho*> todosOsTrechos; ///< Dona dos trechos, para liberação no destrutor.
+
+    /**
+     * @brief Combina os IDs de dois armazéns em uma chave de 64 bits, sem colisões para quaisquer IDs.
+     */
+    static long long chaveTrecho(int origem, int destino);
+
+    /**
+     * @brief Acrescenta uma parada à rota, se o armazém diferir do último visitado.
+     */
+    static void adicionarParada(RotaPacote* rota, int armazem, int chegada);
+};
+
+#endif // INDICE_ROTAS_HPP
@@ -1,7 +1,47 @@
 #ifndef LISTA_HPP
 #define LISTA_HPP
 
+#include <new>
 #include <stdexcept>
+#include <utility>
+#include "Alocador.hpp"
+
+/**
+ * @brief Se diferente de zero, `obter`, `operator[]` e `definir` verificam o índice.
+ *
+ * Por padrão, a verificação é mantida nos builds de depuração e removida nos de
+ * release (`NDEBUG`), onde os acessos indexados compilam para um acesso direto
+ * ao array e laços sobre a lista podem ser vetorizados. Pode ser definida na
+ * linha de comando para forçar um dos modos.
+ */
+#ifndef LISTA_VERIFICAR_LIMITES
+#ifdef NDEBUG
+#define LISTA_VERIFICAR_LIMITES 0
+#else
+#define LISTA_VERIFICAR_LIMITES 1
+#endif
+#endif
+
+/**
+ * @brief Espaço para os primeiros elementos de uma `Lista`, dentro do próprio objeto.
+ *
+ * A especialização para zero elementos é vazia e, como classe base, não ocupa espaço.
+ */
+template <typename T, int Embutidos>
+struct ArmazenamentoEmbutido {
+    alignas(T) unsigned char bytes[Embutidos * sizeof(T)];
+
+    T* embutido() const {
+        return reinterpret_cast<T*>(const_cast<unsigned char*>(bytes));
+    }
+};
+
+template <typename T>
+struct ArmazenamentoEmbutido<T, 0> {
+    T* embutido() const {
+        return nullptr;
+    }
+};
 
 /**
  * @brief Uma implementação de um vetor dinâmico (lista) genérico.
@@ -9,52 +49,130 @@
  * Esta classe fornece uma estrutura de dados de lista que pode crescer dinamicamente.
  * É implementada usando templates para permitir o armazenamento de qualquer tipo de dado.
  * A classe gerencia a memória internamente e se redimensiona conforme necessário.
- * Segue a "Regra dos Três" para garantir o gerenciamento correto da memória (destrutor,
- * construtor de cópia e operador de atribuição de cópia).
+ * Segue a "Regra dos Cinco": destrutor, construtores e operadores de atribuição
+ * de cópia (profunda) e de movimentação.
+ *
+ * Uma lista vazia não aloca memória: o array é alocado na primeira inserção.
+ * Os primeiros `Embutidos` elementos ficam dentro do próprio objeto, de modo que
+ * listas curtas (os clientes de um pacote, por exemplo) não alocam nada. Apenas
+ * as posições até `getTamanho()` contêm elementos construídos.
  *
  * @tparam T O tipo de elemento a ser armazenado na lista.
+ * @tparam Embutidos Número de elementos guardados no próprio objeto, sem alocação.
+ * @tparam Alocador A origem da memória dos elementos; veja `AlocadorPadrao`.
  */
-template <typename T>
-class Lista {
+template <typename T, int Embutidos = 0, typename Alocador = AlocadorPadrao>
+class Lista : private ArmazenamentoEmbutido<T, Embutidos>, private Alocador {
 private:
-    T* elementos;       ///< Ponteiro para o array alocado dinamicamente.
+    static const int CAPACIDADE_INICIAL = 4; ///< Capacidade da primeira alocação, se não houver elementos embutidos.
+
+    T* elementos;       ///< Ponteiro para o array, embutido ou alocado.
     int capacidade;     ///< A capacidade atual do array.
     int quantidade;     ///< O número de elementos atualmente na lista.
 
+    Alocador& alocador() {
+        return *this;
+    }
+
     /**
-     * @brief Redimensiona o array interno para acomodar mais elementos.
-     * 
-     * Dobra a capacidade atual do array. Se a capacidade for 0, define como 1.
-     * Aloca um novo array, copia os elementos existentes e libera o antigo.
+     * @brief Lança `std::out_of_range` se o índice for inválido, quando a verificação está ativa.
      */
-    void redimensionar() {
-        int novaCapacidade = (capacidade == 0) ? 1 : capacidade * 2;
-        T* novosElementos = new T[novaCapacidade];
+    void verificarIndice(int indice) const {
+        if (LISTA_VERIFICAR_LIMITES && (indice < 0 || indice >= quantidade)) {
+            throw std::out_of_range("Índice fora dos limites da lista.");
+        }
+    }
+
+    bool usaEmbutido() const {
+        return elementos == this->embutido();
+    }
+
+    /**
+     * @brief Move os elementos para um array alocado com `novaCapacidade` posições.
+     */
+    void realocar(int novaCapacidade) {
+        T* novosElementos = alocador().template alocar<T>(novaCapacidade);
         for (int i = 0; i < quantidade; ++i) {
-            novosElementos[i] = elementos[i];
+            new (novosElementos + i) T(std::move(elementos[i]));
+            elementos[i].~T();
         }
-        delete[] elementos;
+        liberarArray();
         elementos = novosElementos;
         capacidade = novaCapacidade;
     }
 
+    /**
+     * @brief Redimensiona o array interno para acomodar mais elementos.
+     * 
+     * Dobra a capacidade atual do array, ou aloca `CAPACIDADE_INICIAL` posições
+     * na primeira inserção de uma lista sem elementos embutidos.
+     */
+    void redimensionar() {
+        realocar((capacidade == 0) ? CAPACIDADE_INICIAL : capacidade * 2);
+    }
+
+    /**
+     * @brief Destrói os elementos a partir de `inicio`.
+     */
+    void destruirAPartirDe(int inicio) {
+        for (int i = inicio; i < quantidade; ++i) {
+            elementos[i].~T();
+        }
+        quantidade = inicio;
+    }
+
+    /**
+     * @brief Devolve o array ao alocador, se não for o embutido.
+     */
+    void liberarArray() {
+        if (!usaEmbutido()) {
+            alocador().template liberar<T>(elementos, capacidade);
+        }
+    }
+
+    /**
+     * @brief Assume os elementos de `outra`, que fica vazia; esta lista deve estar vazia e sem array alocado.
+     */
+    void tomar(Lista& outra) {
+        if (outra.usaEmbutido()) {
+            for (int i = 0; i < outra.quantidade; ++i) {
+                new (elementos + i) T(std::move(outra.elementos[i]));
+            }
+            quantidade = outra.quantidade;
+            outra.destruirAPartirDe(0);
+            return;
+        }
+        elementos = outra.elementos;
+        capacidade = outra.capacidade;
+        quantidade = outra.quantidade;
+        outra.elementos = outra.embutido();
+        outra.capacidade = Embutidos;
+        outra.quantidade = 0;
+    }
+
 public:
     /**
      * @brief Construtor padrão.
      * 
-     * Inicializa uma lista vazia com uma capacidade inicial padrão.
+     * Inicializa uma lista vazia, sem alocar memória.
      */
-    Lista() : capacidade(10), quantidade(0) {
-        elementos = new T[capacidade];
-    }
+    Lista() : Alocador(), elementos(this->embutido()), capacidade(Embutidos), quantidade(0) {}
+
+    /**
+     * @brief Construtor com um alocador específico.
+     * @param alocador O alocador que fornecerá a memória da lista.
+     */
+    explicit Lista(const Alocador& alocador)
+        : Alocador(alocador), elementos(this->embutido()), capacidade(Embutidos), quantidade(0) {}
 
     /**
      * @brief Destrutor.
      * 
-     * Libera a memória alocada para os elementos da lista.
+     * Destrói os elementos e libera a memória alocada para eles.
      */
     ~Lista() {
-        delete[] elementos;
+        destruirAPartirDe(0);
+        liberarArray();
     }
 
     /**
@@ -65,15 +183,30 @@ public:
      * 
      * @param outra A lista a ser copiada.
      */
-    Lista(const Lista<T>& outra) {
-        capacidade = outra.capacidade;
-        quantidade = outra.quantidade;
-        elementos = new T[capacidade];
-        for (int i = 0; i < quantidade; ++i) {
-            elementos[i] = outra.elementos[i];
+    Lista(const Lista& outra)
+        : Alocador(outra), elementos(this->embutido()), capacidade(Embutidos), quantidade(0) {
+        if (outra.quantidade > capacidade) {
+            realocar(outra.quantidade);
+        }
+        for (int i = 0; i < outra.quantidade; ++i) {
+            new (elementos + i) T(outra.elementos[i]);
+            quantidade++;
         }
     }
 
+    /**
+     * @brief Construtor de movimentação.
+     *
+     * Assume o array de `outra` sem copiar elementos (exceto os embutidos, que
+     * são movidos um a um). `outra` fica vazia.
+     *
+     * @param outra A lista cujo conteúdo será movido.
+     */
+    Lista(Lista&& outra)
+        : Alocador(outra), elementos(this->embutido()), capacidade(Embutidos), quantidade(0) {
+        tomar(outra);
+    }
+
     /**
      * @brief Operador de atribuição de cópia (Deep Copy).
      * 
@@ -83,20 +216,29 @@ public:
      * @param outra A lista da qual os dados serão copiados.
      * @return Uma referência para a lista atual (`*this`).
      */
-    Lista<T>& operator=(const Lista<T>& outra) {
+    Lista& operator=(const Lista& outra) {
         if (this == &outra) {
             return *this;
         }
+        Lista copia(outra);
+        return *this = std::move(copia);
+    }
 
-        delete[] elementos;
-
-        capacidade = outra.capacidade;
-        quantidade = outra.quantidade;
-        elementos = new T[capacidade];
-        for (int i = 0; i < quantidade; ++i) {
-            elementos[i] = outra.elementos[i];
+    /**
+     * @brief Operador de atribuição de movimentação.
+     * @param outra A lista cujo conteúdo será movido; fica vazia.
+     * @return Uma referência para a lista atual (`*this`).
+     */
+    Lista& operator=(Lista&& outra) {
+        if (this == &outra) {
+            return *this;
         }
-        
+        destruirAPartirDe(0);
+        liberarArray();
+        elementos = this->embutido();
+        capacidade = Embutidos;
+        alocador() = outra.alocador();
+        tomar(outra);
         return *this;
     }
 
@@ -111,29 +253,65 @@ public:
         if (quantidade == capacidade) {
             redimensionar();
         }
-        elementos[quantidade++] = elemento;
+        new (elementos + quantidade) T(std::move(elemento));
+        quantidade++;
+    }
+
+    /**
+     * @brief Insere um elemento em uma posição, deslocando os seguintes uma casa à direita.
+     *
+     * O custo é proporcional ao número de elementos deslocados; inserir no fim
+     * equivale a `adicionar`.
+     *
+     * @param indice A posição do novo elemento, entre 0 e `getTamanho()`.
+     * @param elemento O elemento a ser inserido.
+     * @throws std::out_of_range se o índice for inválido.
+     */
+    void inserir(int indice, T elemento) {
+        if (indice < 0 || indice > quantidade) {
+            throw std::out_of_range("Índice fora dos limites da lista.");
+        }
+        if (indice == quantidade) {
+            adicionar(std::move(elemento));
+            return;
+        }
+        if (quantidade == capacidade) {
+            redimensionar();
+        }
+        new (elementos + quantidade) T(std::move(elementos[quantidade - 1]));
+        for (int i = quantidade - 1; i > indice; --i) {
+            elementos[i] = std::move(elementos[i - 1]);
+        }
+        elementos[indice] = std::move(elemento);
+        quantidade++;
+    }
+
+    /**
+     * @brief Destrói todos os elementos, mantendo a capacidade para reaproveitá-la.
+     */
+    void limpar() {
+        destruirAPartirDe(0);
     }
 
     /**
      * @brief Redimensiona a lista para conter um novo número de elementos.
+     *
+     * Os novos elementos são construídos com `T()`; ao reduzir, os excedentes
+     * são destruídos, mas a capacidade é mantida.
      * 
      * @param novoTamanho O novo tamanho da lista.
      */
     void resize(int novoTamanho) {
         if (novoTamanho < 0) return;
+        if (novoTamanho <= quantidade) {
+            destruirAPartirDe(novoTamanho);
+            return;
+        }
         if (novoTamanho > capacidade) {
-            int novaCapacidade = novoTamanho;
-            T* novosElementos = new T[novaCapacidade];
-            for (int i = 0; i < quantidade; ++i) {
-                novosElementos[i] = elementos[i];
-            }
-            delete[] elementos;
-            elementos = novosElementos;
-            capacidade = novaCapacidade;
+            realocar(novoTamanho);
         }
-
         for (int i = quantidade; i < novoTamanho; ++i) {
-            elementos[i] = T();
+            new (elementos + i) T();
         }
         quantidade = novoTamanho;
     }
@@ -143,12 +321,10 @@ public:
      * 
      * @param indice O índice do elemento a ser obtido.
      * @return Uma referência ao elemento no índice especificado.
-     * @throws std::out_of_range se o índice for inválido.
+     * @throws std::out_of_range se o índice for inválido e `LISTA_VERIFICAR_LIMITES` estiver ativa.
      */
     T& obter(int indice) {
-        if (indice < 0 || indice >= quantidade) {
-            throw std::out_of_range("Índice fora dos limites da lista.");
-        }
+        verificarIndice(indice);
         return elementos[indice];
     }
 
@@ -157,12 +333,10 @@ public:
      * 
      * @param indice O índice do elemento a ser obtido.
      * @return Uma referência constante ao elemento no índice especificado.
-     * @throws std::out_of_range se o índice for inválido.
+     * @throws std::out_of_range se o índice for inválido e `LISTA_VERIFICAR_LIMITES` estiver ativa.
      */
     const T& obter(int indice) const {
-        if (indice < 0 || indice >= quantidade) {
-            throw std::out_of_range("Índice fora dos limites da lista.");
-        }
+        verificarIndice(indice);
         return elementos[indice];
     }
 
@@ -170,12 +344,10 @@ public:
      * @brief Acessa um elemento pelo índice usando o operador [].
      * @param indice O índice do elemento.
      * @return Uma referência ao elemento.
-     * @throws std::out_of_range se o índice for inválido.
+     * @throws std::out_of_range se o índice for inválido e `LISTA_VERIFICAR_LIMITES` estiver ativa.
      */
     T& operator[](int indice) {
-        if (indice < 0 || indice >= quantidade) {
-            throw std::out_of_range("Índice fora dos limites da lista.");
-        }
+        verificarIndice(indice);
         return elementos[indice];
     }
 
@@ -183,31 +355,67 @@ public:
      * @brief Acessa um elemento constante pelo índice usando o operador [].
      * @param indice O índice do elemento.
      * @return Uma referência constante ao elemento.
-     * @throws std::out_of_range se o índice for inválido.
+     * @throws std::out_of_range se o índice for inválido e `LISTA_VERIFICAR_LIMITES` estiver ativa.
      */
     const T& operator[](int indice) const {
-        if (indice < 0 || indice >= quantidade) {
-            throw std::out_of_range("Índice fora dos limites da lista.");
-        }
+        verificarIndice(indice);
         return elementos[indice];
     }
 
-
-    
     /**
      * @brief Define o valor de um elemento em um índice específico.
      *
      * @param indice O índice do elemento a ser modificado.
      * @param valor O novo valor para o elemento.
-     * @throws std::out_of_range se o índice for inválido.
+     * @throws std::out_of_range se o índice for inválido e `LISTA_VERIFICAR_LIMITES` estiver ativa.
      */
     void definir(int indice, T valor) {
-        if (indice < 0 || indice >= quantidade) {
-            throw std::out_of_range("Índice fora dos limites da lista.");
-        }
+        verificarIndice(indice);
         elementos[indice] = valor;
     }
 
+    /**
+     * @brief Retorna um ponteiro para o array contíguo de elementos.
+     *
+     * Permite que rotinas de varredura (e.g., kernels vetorizados) percorram os
+     * elementos sem a verificação de limites de `obter`. O ponteiro é invalidado
+     * por qualquer operação que redimensione a lista.
+     *
+     * @return Ponteiro para o primeiro elemento.
+     */
+    T* dados() {
+        return elementos;
+    }
+
+    /**
+     * @brief Retorna um ponteiro constante para o array contíguo de elementos.
+     * @return Ponteiro constante para o primeiro elemento.
+     */
+    const T* dados() const {
+        return elementos;
+    }
+
+    /**
+     * @brief Iteradores sobre os elementos, em ordem; permitem `for (T& x : lista)`.
+     *
+     * São ponteiros para o array, invalidados como os de `dados()`.
+     */
+    T* begin() {
+        return elementos;
+    }
+
+    T* end() {
+        return elementos + quantidade;
+    }
+
+    const T* begin() const {
+        return elementos;
+    }
+
+    const T* end() const {
+        return elementos + quantidade;
+    }
+
     /**
      * @brief Retorna o número de elementos na lista.
      * 
@@ -217,6 +425,43 @@ public:
         return quantidade;
     }
 
+    /**
+     * @brief Retorna a memória do array alocado e a parte ocupada pelos elementos.
+     *
+     * Elementos embutidos não contam, e a memória apontada pelos elementos fica
+     * a cargo de quem os conhece.
+     */
+    UsoMemoria getUsoMemoria() const {
+        if (usaEmbutido()) {
+            return UsoMemoria();
+        }
+        return UsoMemoria(static_cast<size_t>(capacidade) * sizeof(T), static_cast<size_t>(quantidade) * sizeof(T));
+    }
+
+    /**
+     * @brief Troca o conteúdo desta lista com o de outra em O(1).
+     *
+     * Apenas os ponteiros e contadores são trocados; nenhum elemento é copiado.
+     * Elementos embutidos, por não terem array próprio, são movidos um a um.
+     *
+     * @param outra A lista cujo conteúdo será trocado com o desta.
+     */
+    void trocar(Lista& outra) {
+        if (this == &outra) {
+            return;
+        }
+        if (usaEmbutido() || outra.usaEmbutido()) {
+            Lista temporaria(std::move(outra));
+            outra = std::move(*this);
+            *this = std::move(temporaria);
+            return;
+        }
+        std::swap(elementos, outra.elementos);
+        std::swap(capacidade, outra.capacidade);
+        std::swap(quantidade, outra.quantidade);
+        std::swap(alocador(), outra.alocador());
+    }
+
     /**
      * @brief Verifica se a lista contém um determinado elemento.
      * 
@@ -240,14 +485,70 @@ public:
      */
     void ordenar(bool (*comparar)(T a, T b)) {
         for (int i = 1; i < quantidade; i++) {
-            T chave = elementos[i];
+            T chave = std::move(elementos[i]);
             int j = i - 1;
             while (j >= 0 && comparar(chave, elementos[j])) {
-                elementos[j + 1] = elementos[j];
+                elementos[j + 1] = std::move(elementos[j]);
                 j = j - 1;
             }
-            elementos[j + 1] = chave;
+            elementos[j + 1] = std::move(chave);
+        }
+    }
+
+    /**
+     * @brief Ordena a lista de forma estável usando Merge Sort, em O(n log n).
+     *
+     * Preferível a `ordenar` para listas grandes ou pouco ordenadas; usa um
+     * array auxiliar do mesmo tamanho, que alterna de papel com o principal.
+     *
+     * @param comparar Um ponteiro de função que recebe dois elementos e retorna `true`
+     *                 se o primeiro deve vir antes do segundo.
+     */
+    void ordenarMesclando(bool (*comparar)(const T& a, const T& b)) {
+        if (quantidade < 2) {
+            return;
+        }
+        T* auxiliar = alocador().template alocar<T>(quantidade);
+        for (int i = 0; i < quantidade; ++i) {
+            new (auxiliar + i) T();
+        }
+        T* origem = elementos;
+        T* destino = auxiliar;
+        for (int largura = 1; largura < quantidade; largura *= 2) {
+            for (int inicio = 0; inicio < quantidade; inicio += 2 * largura) {
+                int meio = (inicio + largura < quantidade) ? inicio + largura : quantidade;
+                int fim = (inicio + 2 * largura < quantidade) ? inicio + 2 * largura : quantidade;
+                int i = inicio, j = meio, k = inicio;
+                while (i < meio && j < fim) {
+                    // Em caso de empate, o elemento da metade esquerda vem primeiro.
+                    destino[k++] = std::move(comparar(origem[j], origem[i]) ? origem[j++] : origem[i++]);
+                }
+                while (i < meio) destino[k++] = std::move(origem[i++]);
+                while (j < fim) destino[k++] = std::move(origem[j++]);
+            }
+            T* temp = origem;
+            origem = destino;
+            destino = temp;
+        }
+
+        int capacidadeAuxiliar = quantidade;
+        if (origem == auxiliar) {
+            if (usaEmbutido()) {
+                for (int i = 0; i < quantidade; ++i) {
+                    elementos[i] = std::move(auxiliar[i]);
+                }
+            } else {
+                // O resultado ficou no auxiliar, que passa a ser o array da lista.
+                auxiliar = elementos;
+                capacidadeAuxiliar = capacidade;
+                elementos = origem;
+                capacidade = quantidade;
+            }
+        }
+        for (int i = 0; i < quantidade; ++i) {
+            auxiliar[i].~T();
         }
+        alocador().template liberar<T>(auxiliar, capacidadeAuxiliar);
     }
 };
 
@@ -13,10 +13,14 @@
  * própria definida em `Hash.hpp`. Fornece complexidade de tempo média O(1)
  * para inserção e busca.
  *
+ * A tabela só é alocada na primeira inserção, e cada balde só aloca seu array
+ * ao receber a primeira entrada; um mapa vazio não ocupa memória além do objeto.
+ *
  * @tparam Chave O tipo da chave. Deve ter uma especialização correspondente em `Hash.hpp`.
  * @tparam Valor O tipo do valor associado à chave.
+ * @tparam Alocador A origem da memória da tabela e dos baldes; veja `AlocadorPadrao`.
  */
-template <typename Chave, typename Valor>
+template <typename Chave, typename Valor, typename Alocador = AlocadorPadrao>
 class Mapa {
 private:
     struct Entrada {
@@ -24,7 +28,12 @@ private:
         Valor valor;
     };
 
-    Lista<Lista<Entrada>> tabela;
+    typedef Lista<Entrada, 0, Alocador> Balde;
+
+    static const size_t CAPACIDADE_INICIAL = 8; ///< Baldes alocados na primeira inserção; mapas grandes crescem pelo fator de carga.
+    static const size_t FATOR_CARGA_MAXIMO = 4; ///< Média de entradas por balde antes de crescer.
+
+    Lista<Balde, 0, Alocador> tabela;
     size_t tamanho;
     size_t capacidade;
 
@@ -32,14 +41,36 @@ private:
         return Hash<Chave>{}(chave) % capacidade;
     }
 
-public:
     /**
-     * @brief Construtor padrão. Cria um mapa vazio com capacidade inicial.
+     * @brief Dobra o número de baldes e redistribui todas as entradas.
+     *
+     * Chamado quando o fator de carga ultrapassa `FATOR_CARGA_MAXIMO`, mantendo
+     * os baldes curtos mesmo com milhões de chaves.
      */
-    Mapa() : tamanho(0), capacidade(100) {
-        tabela.resize(capacidade);
+    void redimensionarTabela() {
+        size_t novaCapacidade = capacidade * 2;
+        Lista<Balde, 0, Alocador> novaTabela;
+        novaTabela.resize(static_cast<int>(novaCapacidade));
+
+        for (int j = 0; j < tabela.getTamanho(); ++j) {
+            Balde& balde = tabela.obter(j);
+            for (int i = 0; i < balde.getTamanho(); ++i) {
+                Entrada& entrada = balde.obter(i);
+                size_t indice = Hash<Chave>{}(entrada.chave) % novaCapacidade;
+                novaTabela[static_cast<int>(indice)].adicionar(std::move(entrada));
+            }
+        }
+
+        tabela.trocar(novaTabela);
+        capacidade = novaCapacidade;
     }
 
+public:
+    /**
+     * @brief Construtor padrão. Cria um mapa vazio, sem alocar a tabela.
+     */
+    Mapa() : tamanho(0), capacidade(0) {}
+
     /**
      * @brief Destrutor. Libera todos os recursos alocados.
      */
@@ -55,8 +86,12 @@ public:
      * @param valor O valor associado à chave.
      */
     void inserir(Chave chave, Valor valor) {
+        if (capacidade == 0) {
+            capacidade = CAPACIDADE_INICIAL;
+            tabela.resize(static_cast<int>(capacidade));
+        }
         size_t indice = hash(chave);
-        Lista<Entrada>& balde = tabela[indice];
+        Balde& balde = tabela[indice];
 
         for (int i = 0; i < balde.getTamanho(); ++i) {
             if (balde.obter(i).chave == chave) {
@@ -67,6 +102,59 @@ public:
 
         balde.adicionar({chave, valor});
         tamanho++;
+
+        if (tamanho > capacidade * FATOR_CARGA_MAXIMO) {
+            redimensionarTabela();
+        }
+    }
+
+    /**
+     * @brief Remove uma chave do mapa, se presente.
+     *
+     * A entrada removida é substituída pela última do balde, evitando
+     * deslocar os demais elementos.
+     *
+     * @param chave A chave a ser removida.
+     * @return `true` se a chave existia e foi removida, `false` caso contrário.
+     */
+    bool remover(Chave chave) {
+        if (tamanho == 0) {
+            return false;
+        }
+        size_t indice = hash(chave);
+        Balde& balde = tabela[indice];
+
+        for (int i = 0; i < balde.getTamanho(); ++i) {
+            if (balde.obter(i).chave == chave) {
+                balde.definir(i, std::move(balde.obter(balde.getTamanho() - 1)));
+                balde.resize(balde.getTamanho() - 1);
+                tamanho--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Retorna o número de chaves armazenadas no mapa.
+     * @return A quantidade de pares chave-valor.
+     */
+    size_t getTamanho() const {
+        return tamanho;
+    }
+
+    /**
+     * @brief Retorna a memória da tabela e dos baldes; só as entradas contam como usadas.
+     *
+     * A tabela e a folga dos baldes são o custo fixo do mapa. A memória apontada
+     * pelas chaves e pelos valores fica a cargo de quem os conhece.
+     */
+    UsoMemoria getUsoMemoria() const {
+        UsoMemoria uso(tabela.getUsoMemoria().alocados, tamanho * sizeof(Entrada));
+        for (const Balde& balde : tabela) {
+            uso.alocados += balde.getUsoMemoria().alocados;
+        }
+        return uso;
     }
 
     /**
@@ -77,8 +165,11 @@ public:
      *         um valor padrão para o tipo `Valor` (e.g., `nullptr` para ponteiros).
      */
     Valor buscar(Chave chave) const {
+        if (tamanho == 0) {
+            return Valor();
+        }
         size_t indice = hash(chave);
-        const Lista<Entrada>& balde = tabela[indice];
+        const Balde& balde = tabela[indice];
 
         for (int i = 0; i < balde.getTamanho(); ++i) {
             if (balde.obter(i).chave == chave) {
@@ -90,14 +181,45 @@ public:
     }
 
     /**
-     * @brief Retorna todos os valores armazenados no mapa.
+     * @brief Chama `visitante(chave, valor)` para cada entrada, sem copiar as entradas.
+     *
+     * A ordem é a dos baldes, a mesma de `obterValores`. O visitante pode alterar
+     * o valor, mas não inserir nem remover chaves durante a visita.
+     *
+     * @param visitante Função ou lambda que recebe `(const Chave&, Valor&)`.
+     */
+    template <typename Visitante>
+    void paraCada(Visitante visitante) {
+        for (Balde& balde : tabela) {
+            for (Entrada& entrada : balde) {
+                visitante(static_cast<const Chave&>(entrada.chave), entrada.valor);
+            }
+        }
+    }
+
+    /**
+     * @brief Versão constante de `paraCada`; o visitante recebe `(const Chave&, const Valor&)`.
+     */
+    template <typename Visitante>
+    void paraCada(Visitante visitante) const {
+        for (const Balde& balde : tabela) {
+            for (const Entrada& entrada : balde) {
+                visitante(entrada.chave, entrada.valor);
+            }
+        }
+    }
+
+    /**
+     * @brief Retorna uma cópia de todos os valores armazenados no mapa.
+     *
+     * Para apenas percorrer as entradas, `paraCada` evita a cópia.
      * 
      * @return Uma `Lista` contendo todos os valores.
      */
     Lista<Valor> obterValores() const {
         Lista<Valor> listaDeValores;
         for (int j = 0; j < tabela.getTamanho(); ++j) {
-            const Lista<Entrada>& balde = tabela.obter(j);
+            const Balde& balde = tabela.obter(j);
             for (int i = 0; i < balde.getTamanho(); ++i) {
                 listaDeValores.adicionar(balde.obter(i).valor);
             }
@@ -0,0 +1,431 @@
+#ifndef MOTOR_LOGISTICO_HPP
+#define MOTOR_LOGISTICO_HPP
+
+#include <string>
+#include "Evento.hpp"
+#include "Lista.hpp"
+#include "Mapa.hpp"
+#include "RankingsAtividade.hpp"
+#include "IndiceRotas.hpp"
+#include "ColecaoSegmentos.hpp"
+#include "HistoricoPacote.hpp"
+#include "IndiceAssinaturas.hpp"
+#include "RelatorioMemoria.hpp"
+
+/**
+ * @brief Estrutura para armazenar os pacotes associados a um cliente.
+ *
+ * Separa os pacotes em duas listas: os que foram enviados pelo cliente e os que
+ * ele deve receber. As listas guardam os primeiros pacotes no próprio objeto; a
+ * maioria dos clientes tem entre 10 e 20 em cada uma e não aloca nada além do objeto.
+ */
+struct PacotesCliente {
+    static const int PACOTES_EMBUTIDOS = 20; ///< Pacotes guardados sem alocação em cada lista.
+
+    Lista<int, PACOTES_EMBUTIDOS> enviados;
+    Lista<int, PACOTES_EMBUTIDOS> aReceber;
+    long versao;     ///< Alterada sempre que um evento toca um dos pacotes do cliente.
+    int ultimoTempo; ///< Maior timestamp entre os eventos dos pacotes do cliente.
+
+    PacotesCliente() : versao(0), ultimoTempo(0) {}
+};
+
+/**
+ * @brief Os eventos de um pacote e os clientes que o listam.
+ */
+struct EventosPacote {
+    int idPacote;
+    HistoricoPacote historico;       ///< Eventos residentes do pacote, codificados em ordem de tempo.
+    Lista<PacotesCliente*, 2> clientes; ///< Clientes cuja versão é alterada pelos eventos do pacote (remetente e destinatário, sem alocação).
+
+    explicit EventosPacote(int idPacote) : idPacote(idPacote) {}
+};
+
+/**
+ * @brief Identifica o estado dos dados de um cliente, para validar resultados em cache.
+ *
+ * Um resultado de CL calculado no instante `t1` continua válido no instante `t2`
+ * se a versão não mudou e `t2 == t1`, ou se `ultimoTempo` não ultrapassa nenhum
+ * dos dois instantes (ambas as consultas enxergam todos os eventos do cliente).
+ */
+struct VersaoCliente {
+    long versao;
+    int ultimoTempo;
+};
+
+/**
+ * @brief Parâmetros opcionais do `MotorLogistico`.
+ */
+struct OpcoesMotor {
+    int capacidadeRanking;   ///< Número de chaves mantidas em cada ranking de atividade.
+    bool rankingAproximado;  ///< Se `true`, os rankings estimam contagens com Count-Min Sketch.
+    bool manterRankings;     ///< Se `false`, o motor não mantém rankings (e.g., em uma partição).
+    int janelaRetencao;      ///< Tempo após a entrega (EN) até o pacote ser arquivado; -1 desativa.
+    long memoriaMaxima;      ///< Bytes de eventos residentes antes de um despejo em disco; 0 desativa.
+    std::string diretorioSegmentos; ///< Onde criar os segmentos em disco; vazio usa `$TMPDIR` ou `/tmp`.
+
+    OpcoesMotor() : capacidadeRanking(10), rankingAproximado(false), manterRankings(true), janelaRetencao(-1),
+                    memoriaMaxima(0) {}
+};
+
+/**
+ * @brief Função chamada para cada evento de um resultado de consulta.
+ * @param ev O evento do resultado.
+ * @param contexto O ponteiro opaco repassado pelo chamador.
+ */
+typedef void (*CallbackEvento)(const Evento& ev, void* contexto);
+
+/**
+ * @brief Motor de indexação e consulta do sistema logístico, embutível em outros programas.
+ *
+ * @details Recebe eventos já tipados, sem passar pelo formato texto, e mantém
+ * todos os índices usados pelas consultas: o histórico codificado de cada
+ * pacote (`HistoricoPacote`), as contagens por tipo da CE, os mapas de
+ * pacotes e clientes, os rankings de atividade e o índice de rotas.
+ * As consultas devolvem estruturas de resultado ou invocam um callback por
+ * evento; nenhuma delas escreve na saída padrão. O `Carregamento` é apenas um
+ * cliente deste motor que lê e escreve o formato texto.
+ *
+ * Consultas CL e PC também podem ser assinadas (`assinarCliente`,
+ * `assinarPacote`): a ingestão passa pelo `IndiceAssinaturas`, que enfileira
+ * apenas as mudanças nas respostas assinadas, coletadas com `coletarNotificacoes`.
+ * Sem assinaturas, o custo na ingestão é um teste de ponteiro.
+ *
+ * Com `OpcoesMotor::janelaRetencao` ativa, pacotes entregues há mais que a
+ * janela (em relação ao maior timestamp ingerido) são arquivados: o histórico
+ * é recodificado e o pacote mantém apenas o evento de registro e o último evento,
+ * que bastam para a consulta CL; sua rota é descartada. Os eventos removidos
+ * continuam somados em CE, e rankings e trechos não são afetados. PC e RT sobre
+ * um pacote arquivado respondem apenas com o que restou. A compactação ocorre
+ * quando os eventos a remover chegam a um quarto dos residentes, o que mantém
+ * seu custo amortizado constante por evento.
+ *
+ * Com `OpcoesMotor::memoriaMaxima` ativa, os históricos são copiados, ainda
+ * codificados, para um segmento imutável em disco (`ColecaoSegmentos`) sempre
+ * que a estimativa de tamanho dos eventos residentes atinge o orçamento, e são
+ * esvaziados. Mapas de clientes e pacotes, rotas, trechos e rankings continuam
+ * residentes. PC e CL passam a juntar o histórico de cada pacote nos segmentos
+ * e na memória; CE soma as contagens dos segmentos. A retenção só compacta os
+ * eventos ainda residentes.
+ */
+class MotorLogistico {
+public:
+    /**
+     * @brief Construtor.
+     * @param opcoes Parâmetros opcionais do motor.
+     */
+    explicit MotorLogistico(const OpcoesMotor& opcoes = OpcoesMotor());
+
+    /**
+     * @brief Destrutor. Libera todos os índices.
+     */
+    ~MotorLogistico();
+
+    MotorLogistico(const MotorLogistico&) = delete;
+    MotorLogistico& operator=(const MotorLogistico&) = delete;
+
+    /**
+     * @brief Indexa um evento.
+     *
+     * Os eventos de cada pacote são mantidos em ordem de tempo mesmo
+     * que os eventos cheguem fora de ordem, então PC e CL permanecem corretas. As
+     * rotas, os trânsitos e os rankings, porém, são atualizados na ordem de
+     * ingestão; feeds com atraso devem passar antes por um `BufferReordenacao`.
+     *
+     * @param ev O evento a ser ingerido.
+     * @return `false` se o evento for de tipo INDEFINIDO e tiver sido ignorado.
+     */
+    bool ingerir(const Evento& ev);
+
+    /**
+     * @brief Indexa um lote de eventos, na ordem em que aparecem.
+     * @param eventos Ponteiro para o primeiro evento do lote.
+     * @param quantidade Número de eventos no lote.
+     * @return O número de eventos efetivamente ingeridos.
+     */
+    int ingerirLote(const Evento* eventos, int quantidade);
+
+    /**
+     * @brief Consulta o histórico de um pacote até um instante (consulta PC).
+     * @param tempo O timestamp da consulta.
+     * @param idPacote O ID do pacote.
+     * @return Os eventos do pacote com timestamp até `tempo`, em ordem de tempo (e de ingestão, nos empates).
+     */
+    Lista<Evento> consultarPacote(int tempo, int idPacote) const;
+
+    /**
+     * @brief Versão da consulta PC que entrega cada evento a um callback.
+     * @return O número de eventos entregues.
+     */
+    int consultarPacote(int tempo, int idPacote, CallbackEvento callback, void* contexto) const;
+
+    /**
+     * @brief Consulta o estado dos pacotes de um cliente em um instante (consulta CL).
+     *
+     * Para cada pacote enviado ou a receber pelo cliente, retorna o evento de
+     * registro (RG) e o último evento até `tempo`, ordenados por tempo e ID do pacote.
+     *
+     * @param tempo O timestamp da consulta.
+     * @param nomeCliente O nome do cliente.
+     * @return Os eventos resultantes.
+     */
+    Lista<Evento> consultarCliente(int tempo, const std::string& nomeCliente) const;
+
+    /**
+     * @brief Versão da consulta CL que entrega cada evento a um callback.
+     * @return O número de eventos entregues.
+     */
+    int consultarCliente(int tempo, const std::string& nomeCliente, CallbackEvento callback, void* contexto) const;
+
+    /**
+     * @brief Obtém a versão atual dos dados de um cliente.
+     * @param nomeCliente O nome do cliente.
+     * @param versao Recebe a versão.
+     * @return `false` se o cliente não for conhecido.
+     */
+    bool obterVersaoCliente(const std::string& nomeCliente, VersaoCliente& versao) const;
+
+    /**
+     * @brief Retorna os clientes com mais pacotes enviados, em ordem decrescente.
+     *
+     * Os três rankings retornam listas vazias se `OpcoesMotor::manterRankings` for `false`.
+     *
+     * @param quantidade O número de entradas desejadas (limitado à capacidade do ranking).
+     */
+    Lista<ItemRanking<std::string>> consultarRankingRemetentes(int quantidade) const;
+
+    /**
+     * @brief Retorna os clientes com mais pacotes a receber, em ordem decrescente.
+     * @param quantidade O número de entradas desejadas (limitado à capacidade do ranking).
+     */
+    Lista<ItemRanking<std::string>> consultarRankingDestinatarios(int quantidade) const;
+
+    /**
+     * @brief Retorna os armazéns com mais movimentações (AR, TR e EN), em ordem decrescente.
+     * @param quantidade O número de entradas desejadas (limitado à capacidade do ranking).
+     */
+    Lista<ItemRanking<int>> consultarRankingArmazens(int quantidade) const;
+
+    /**
+     * @brief Consulta a rota de um pacote até um instante (consulta RT).
+     * @param tempo O timestamp da consulta; apenas chegadas até ele são retornadas.
+     * @param idPacote O ID do pacote.
+     * @return As paradas do pacote, em ordem de chegada.
+     */
+    Lista<ParadaRota> consultarRota(int tempo, int idPacote) const;
+
+    /**
+     * @brief Consulta a latência de um trecho entre armazéns (consulta LA).
+     * @param origem O armazém de partida.
+     * @param destino O armazém de chegada.
+     * @param resumo Recebe as estatísticas do trecho.
+     * @return `false` se nenhum trânsito foi concluído no trecho.
+     */
+    bool consultarTrecho(int origem, int destino, ResumoTrecho& resumo) const;
+
+    /**
+     * @brief Copia as estatísticas brutas de um trecho, mescláveis com as de outros motores.
+     * @param origem O armazém de partida.
+     * @param destino O armazém de chegada.
+     * @param estatisticas Recebe as estatísticas do trecho.
+     * @return `false` se nenhum trânsito foi concluído no trecho.
+     */
+    bool obterEstatisticasTrecho(int origem, int destino, EstatisticasTrecho& estatisticas) const;
+
+    /**
+     * @brief Conta os eventos de cada tipo até um instante (consulta CE).
+     * @param tempo O timestamp da consulta.
+     * @param contagens Array com uma posição por `TipoEvento` (incluindo INDEFINIDO).
+     */
+    void contarEventos(int tempo, long* contagens) const;
+
+    /**
+     * @brief Assina a resposta de CL de um cliente (consulta permanente).
+     *
+     * A partir daqui, cada evento ingerido que se torna o RG ou o último evento
+     * de um pacote do cliente, ou que associa um novo pacote a ele, gera uma
+     * `Notificacao`. O cliente não precisa ser conhecido ainda.
+     *
+     * @return `false` se o cliente já estava assinado.
+     */
+    bool assinarCliente(const std::string& nomeCliente);
+
+    /**
+     * @brief Assina a resposta de PC de um pacote: cada evento ingerido do pacote gera uma `Notificacao`.
+     * @return `false` se o pacote já estava assinado.
+     */
+    bool assinarPacote(int idPacote);
+
+    /**
+     * @brief Cancela a assinatura de CL de um cliente.
+     * @return `false` se o cliente não estava assinado.
+     */
+    bool cancelarAssinaturaCliente(const std::string& nomeCliente);
+
+    /**
+     * @brief Cancela a assinatura de PC de um pacote.
+     * @return `false` se o pacote não estava assinado.
+     */
+    bool cancelarAssinaturaPacote(int idPacote);
+
+    /**
+     * @brief Indica se a ingestão gerou notificações ainda não coletadas.
+     */
+    bool temNotificacoes() const { return assinaturas != nullptr && assinaturas->temNotificacoes(); }
+
+    /**
+     * @brief Move as notificações pendentes, em ordem de ingestão dos eventos, para o fim de `notificacoes`.
+     *
+     * As notificações se acumulam até serem coletadas; quem assina deve coletá-las
+     * periodicamente (e.g., após cada evento ou lote).
+     *
+     * @return O número de notificações movidas.
+     */
+    int coletarNotificacoes(Lista<Notificacao>& notificacoes);
+
+    /**
+     * @brief Retorna o número de eventos residentes em memória.
+     */
+    int getQuantidadeEventos() const { return eventosResidentes; }
+
+    /**
+     * @brief Retorna o número de eventos despejados em segmentos em disco.
+     */
+    long getEventosEmDisco() const { return segmentos != nullptr ? segmentos->getQuantidadeEventos() : 0; }
+
+    /**
+     * @brief Retorna o número de segmentos em disco (0 se o modo externo estiver desativado).
+     */
+    int getQuantidadeSegmentos() const { return segmentos != nullptr ? segmentos->getQuantidadeSegmentos() : 0; }
+
+    /**
+     * @brief Retorna o número de pacotes arquivados pela política de retenção.
+     */
+    long getPacotesArquivados() const { return pacotesArquivados; }
+
+    /**
+     * @brief Retorna o número de eventos removidos pelas compactações.
+     */
+    long getEventosCompactados() const { return eventosCompactados; }
+
+    /**
+     * @brief Retorna os rankings de atividade, ou `nullptr` se estiverem desativados.
+     */
+    const RankingsAtividade* getRankings() const { return rankings; }
+
+    /**
+     * @brief Registra em `relatorio` a memória de cada estrutura do motor.
+     *
+     * Percorre todos os pacotes e clientes; deve ser chamado pela thread que
+     * ingere os eventos, ou com a ingestão parada. Os segmentos em disco são
+     * mapeados do arquivo e aparecem apenas na memória residente.
+     */
+    void medirMemoria(RelatorioMemoria& relatorio) const;
+
+private:
+    int eventosResidentes;                    ///< Eventos nos históricos em memória.
+    long contagensResidentes[INDEFINIDO + 1]; ///< Eventos nos históricos em memória, por tipo, somados em CE.
+
+    // Os mapas abaixo são índices para acesso rápido aos dados.
+    // Eles armazenam ponteiros para listas/objetos, que são alocados dinamicamente
+    // e devem ser liberadas manualmente no destrutor.
+    Mapa<int, EventosPacote*>* mapaPacotes;           ///< Mapeia ID do pacote para seu histórico e clientes.
+    Mapa<std::string, PacotesCliente*>* mapaClientes; ///< Mapeia nome do cliente para seus pacotes (enviados/a receber).
+
+    RankingsAtividade* rankings; ///< Rankings de atividade, ou `nullptr` se desativados nas opções.
+
+    IndiceRotas* indiceRotas; ///< Rotas dos pacotes e latência dos trechos entre armazéns.
+    long contadorVersoes;     ///< Gerador das versões dos clientes, nunca reutilizadas.
+
+    /**
+     * @brief Uma entrega (EN) aguardando o fim da janela de retenção.
+     */
+    struct Entrega {
+        int idPacote;
+        int tempo;
+    };
+
+    // Estado da política de retenção.
+    int janelaRetencao;
+    int maiorTempo;                      ///< Maior timestamp ingerido; também limita os históricos lidos pela CE.
+    Lista<Entrega> entregas;             ///< Fila de entregas, em ordem de ingestão.
+    int inicioEntregas;                  ///< Primeira entrega ainda dentro da janela.
+    Lista<int> pacotesAArquivar;         ///< Pacotes fora da janela, arquivados na próxima compactação.
+    long eventosAArquivar;               ///< Estimativa dos eventos removidos na próxima compactação.
+    long contagensArquivadas[INDEFINIDO + 1]; ///< Eventos removidos, por tipo, somados em CE.
+    long pacotesArquivados;
+    long eventosCompactados;
+
+    /**
+     * @brief Estimativa do custo residente de um evento: o histórico codificado
+     *        (cerca de 5 bytes) e a folga de crescimento das listas.
+     */
+    static const long BYTES_POR_EVENTO = 11;
+
+    IndiceAssinaturas* assinaturas; ///< Consultas permanentes, ou `nullptr` antes da primeira assinatura.
+
+    ColecaoSegmentos* segmentos;  ///< Segmentos em disco, ou `nullptr` se o modo externo estiver desativado.
+    int limiteEventosResidentes;  ///< Eventos residentes que disparam um despejo.
+
+    /**
+     * @brief Grava os históricos residentes em um novo segmento e esvazia a memória.
+     */
+    void despejar();
+
+    /**
+     * @brief Coleta, sem repetição, os IDs dos pacotes enviados e a receber por um cliente.
+     */
+    static void coletarIdsCliente(const PacotesCliente* pacotesCliente, Lista<int>& ids);
+
+    /**
+     * @brief Enfileira para arquivamento os pacotes cuja entrega saiu da janela.
+     */
+    void aplicarRetencao();
+
+    /**
+     * @brief Arquiva os pacotes enfileirados, recodificando seus históricos.
+     */
+    void compactar();
+
+    /**
+     * @brief Associa um cliente a um pacote para a invalidação de versões.
+     */
+    static void vincularCliente(EventosPacote* pacote, PacotesCliente* cliente);
+
+    /**
+     * @brief Junta o histórico de um pacote até `tempo`, dos segmentos e da memória, em ordem de tempo.
+     */
+    void coletarHistorico(int tempo, int idPacote, Lista<Evento>& saida) const;
+
+    /**
+     * @brief Encontra o RG e o último evento de um pacote até `tempo`, dos segmentos e da memória.
+     */
+    void selecionarPacote(int tempo, int idPacote, SelecaoCliente& selecao) const;
+
+    /**
+     * @brief Atualiza as assinaturas afetadas por um evento recém-ingerido.
+     */
+    void notificarAssinantes(const Evento& ev);
+
+    /**
+     * @brief Passa a observar o pacote de um RG em nome da assinatura do cliente, se houver uma.
+     */
+    void vincularAssinante(const std::string& nomeCliente, const Evento& ev);
+
+    /**
+     * @brief Seleciona os eventos que compõem a resposta de uma consulta CL.
+     */
+    void selecionarEventosCliente(int tempo, const std::string& nomeCliente, Lista<Evento>& saida) const;
+
+    /**
+     * @brief Ordena uma lista de eventos por tempo e, como critério de desempate, por ID do pacote.
+     * @param eventos A lista de eventos a ser ordenada.
+     */
+    static void ordenarEventos(Lista<Evento>& eventos);
+
+    static bool compararEventos(const Evento& a, const Evento& b);
+
+    static bool precedeNoTempo(const Evento& a, const Evento& b);
+};
+
+#endif // MOTOR_LOGISTICO_HPP
@@ -0,0 +1,190 @@
+#ifndef RANKING_TOP_K_HPP
+#define RANKING_TOP_K_HPP
+
+#include "Lista.hpp"
+#include "Mapa.hpp"
+#include "CountMinSketch.hpp"
+#include "RelatorioMemoria.hpp"
+
+/**
+ * @brief Uma entrada do ranking: a chave e sua contagem de atividade.
+ * @tparam Chave O tipo da chave ranqueada.
+ */
+template <typename Chave>
+struct ItemRanking {
+    Chave chave;
+    long contagem;
+};
+
+/**
+ * @brief Mantém incrementalmente as K chaves de maior atividade.
+ *
+ * @details As K chaves de maior contagem ficam em um heap de mínimo indexado:
+ * `posicoes` associa cada chave presente no heap à sua posição, permitindo
+ * atualizar a contagem de uma chave já ranqueada sem busca linear. Como as
+ * contagens só crescem, uma chave fora do heap só entra nele ao superar a raiz
+ * na ordem do ranking (maior contagem e, no empate, menor chave), e cada
+ * incremento custa O(log K) além de uma busca em tabela de hash. Com a mesma
+ * ordem no heap e na saída, o resultado exato não depende da ordem de chegada.
+ *
+ * No modo exato, as contagens de todas as chaves ficam em um `Mapa`. No modo
+ * aproximado, elas são estimadas por um `CountMinSketch` de memória fixa, de
+ * modo que apenas as K chaves ranqueadas ocupam memória proporcional ao seu número.
+ *
+ * @tparam Chave O tipo da chave. Deve ter uma especialização correspondente em `Hash.hpp`.
+ */
+template <typename Chave>
+class RankingTopK {
+private:
+    int k;                              ///< Número máximo de chaves ranqueadas.
+    Lista<ItemRanking<Chave>> heap;     ///< Heap com o pior item na raiz, na ordem de `compararItens`.
+    Mapa<Chave, int> posicoes;          ///< Posição no heap + 1 (0 indica ausência).
+    Mapa<Chave, long>* contagens;       ///< Contagens exatas (nulo no modo aproximado).
+    CountMinSketch<Chave>* sketch;      ///< Estimador de contagens (nulo no modo exato).
+
+    void trocar(int a, int b) {
+        ItemRanking<Chave> temp = heap[a];
+        heap[a] = heap[b];
+        heap[b] = temp;
+        posicoes.inserir(heap[a].chave, a + 1);
+        posicoes.inserir(heap[b].chave, b + 1);
+    }
+
+    void subir(int i) {
+        while (i > 0) {
+            int pai = (i - 1) / 2;
+            if (!compararItens(heap[pai], heap[i])) break;
+            trocar(i, pai);
+            i = pai;
+        }
+    }
+
+    void descer(int i) {
+        int n = heap.getTamanho();
+        while (true) {
+            int menor = i;
+            int esq = 2 * i + 1;
+            int dir = esq + 1;
+            if (esq < n && compararItens(heap[menor], heap[esq])) menor = esq;
+            if (dir < n && compararItens(heap[menor], heap[dir])) menor = dir;
+            if (menor == i) break;
+            trocar(i, menor);
+            i = menor;
+        }
+    }
+
+    /**
+     * @brief Indica se `a` precede `b` no ranking: maior contagem e, no empate, menor chave.
+     */
+    static bool compararItens(const ItemRanking<Chave>& a, const ItemRanking<Chave>& b) {
+        if (a.contagem != b.contagem) {
+            return a.contagem > b.contagem;
+        }
+        return a.chave < b.chave;
+    }
+
+public:
+    /**
+     * @brief Construtor.
+     * @param k Número de chaves mantidas no ranking.
+     * @param aproximado Se `true`, usa um Count-Min Sketch no lugar das contagens exatas.
+     */
+    RankingTopK(int k, bool aproximado = false) : k(k), contagens(nullptr), sketch(nullptr) {
+        if (aproximado) {
+            sketch = new CountMinSketch<Chave>();
+        } else {
+            contagens = new Mapa<Chave, long>();
+        }
+    }
+
+    /**
+     * @brief Destrutor. Libera o armazenamento de contagens.
+     */
+    ~RankingTopK() {
+        delete contagens;
+        delete sketch;
+    }
+
+    RankingTopK(const RankingTopK&) = delete;
+    RankingTopK& operator=(const RankingTopK&) = delete;
+
+    /**
+     * @brief Registra atividade para uma chave e atualiza o ranking.
+     * @param chave A chave que teve atividade.
+     * @param delta O incremento da contagem (deve ser positivo).
+     */
+    void incrementar(const Chave& chave, long delta = 1) {
+        long novaContagem;
+        if (contagens != nullptr) {
+            novaContagem = contagens->buscar(chave) + delta;
+            contagens->inserir(chave, novaContagem);
+        } else {
+            novaContagem = sketch->incrementar(chave, delta);
+        }
+
+        int posicao = posicoes.buscar(chave) - 1;
+        if (posicao >= 0) {
+            heap[posicao].contagem = novaContagem;
+            descer(posicao);
+        } else if (heap.getTamanho() < k) {
+            heap.adicionar({chave, novaContagem});
+            posicoes.inserir(chave, heap.getTamanho());
+            subir(heap.getTamanho() - 1);
+        } else if (k > 0 && compararItens({chave, novaContagem}, heap[0])) {
+            posicoes.remover(heap[0].chave);
+            heap[0].chave = chave;
+            heap[0].contagem = novaContagem;
+            posicoes.inserir(chave, 1);
+            descer(0);
+        }
+    }
+
+    /**
+     * @brief Retorna as `n` chaves de maior contagem em ordem decrescente.
+     *
+     * Empates são desfeitos pela ordem crescente da chave. Custa O(K log K),
+     * independentemente do número total de chaves observadas.
+     *
+     * @param n Número de entradas desejadas (limitado a K).
+     * @return Uma `Lista` com as entradas ordenadas.
+     */
+    Lista<ItemRanking<Chave>> obterMaiores(int n) const {
+        Lista<ItemRanking<Chave>> resultado = heap;
+        resultado.ordenarMesclando(compararItens);
+        if (n < resultado.getTamanho()) {
+            resultado.resize(n < 0 ? 0 : n);
+        }
+        return resultado;
+    }
+
+    /**
+     * @brief Retorna o número máximo de chaves mantidas no ranking.
+     */
+    int getK() const {
+        return k;
+    }
+
+    /**
+     * @brief Retorna a memória do heap, dos mapas, do sketch e das chaves, guardadas em cada um deles.
+     */
+    UsoMemoria getUsoMemoria() const {
+        UsoMemoria uso = heap.getUsoMemoria();
+        for (const ItemRanking<Chave>& item : heap) {
+            uso += usoConteudo(item.chave);
+        }
+        uso += posicoes.getUsoMemoria();
+        posicoes.paraCada([&uso](const Chave& chave, int) { uso += usoConteudo(chave); });
+        if (contagens != nullptr) {
+            uso += usoObjeto(contagens);
+            uso += contagens->getUsoMemoria();
+            contagens->paraCada([&uso](const Chave& chave, long) { uso += usoConteudo(chave); });
+        }
+        if (sketch != nullptr) {
+            uso += usoObjeto(sketch);
+            uso += sketch->getUsoMemoria();
+        }
+        return uso;
+    }
+};
+
+#endif // RANKING_TOP_K_HPP
@@ -0,0 +1,59 @@
+#ifndef RANKINGS_ATIVIDADE_HPP
+#define RANKINGS_ATIVIDADE_HPP
+
+#include <string>
+#include "Evento.hpp"
+#include "RankingTopK.hpp"
+
+/**
+ * @brief Rankings de atividade de clientes e armazéns, atualizados a cada evento.
+ *
+ * Agrupa os três rankings expostos pela consulta RK: remetentes e destinatários
+ * (contados nos eventos RG) e armazéns (contados nos eventos AR, TR e EN).
+ */
+class RankingsAtividade {
+public:
+    /**
+     * @brief Construtor.
+     * @param capacidade Número de chaves mantidas em cada ranking.
+     * @param aproximado Se `true`, as contagens são estimadas com Count-Min Sketch.
+     */
+    RankingsAtividade(int capacidade, bool aproximado);
+    ~RankingsAtividade();
+
+    RankingsAtividade(const RankingsAtividade&) = delete;
+    RankingsAtividade& operator=(const RankingsAtividade&) = delete;
+
+    /**
+     * @brief Atualiza os rankings com um novo evento.
+     * @param ev O evento ingerido.
+     */
+    void registrarEvento(const Evento& ev);
+
+    /**
+     * @brief Retorna os clientes com mais pacotes enviados, em ordem decrescente.
+     */
+    Lista<ItemRanking<std::string>> maioresRemetentes(int quantidade) const;
+
+    /**
+     * @brief Retorna os clientes com mais pacotes a receber, em ordem decrescente.
+     */
+    Lista<ItemRanking<std::string>> maioresDestinatarios(int quantidade) const;
+
+    /**
+     * @brief Retorna os armazéns com mais movimentações, em ordem decrescente.
+     */
+    Lista<ItemRanking<int>> maioresArmazens(int quantidade) const;
+
+    /**
+     * @brief Retorna a memória dos três rankings, incluindo as chaves.
+     */
+    UsoMemoria getUsoMemoria() const;
+
+private:
+    RankingTopK<std::string>* rankingRemetentes;    ///< Clientes com mais pacotes registrados como remetente.
+    RankingTopK<std::string>* rankingDestinatarios; ///< Clientes com mais pacotes registrados como destinatário.
+    RankingTopK<int>* rankingArmazens;              ///< Armazéns com mais movimentações (AR, TR e EN).
+};
+
+#endif // RANKINGS_ATIVIDADE_HPP
@@ -0,0 +1,103 @@
+#ifndef RASTREAMENTO_HPP
+#define RASTREAMENTO_HPP
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+/**
+ * @brief Um intervalo medido (span) de uma thread.
+ */
+struct RegistroSpan {
+    const char* nome;           ///< Nome da fase; deve ser um literal (não é copiado).
+    const char* nomeArgumento;  ///< Nome do argumento, ou `nullptr` se não houver.
+    long argumento;             ///< E.g., a primeira linha do lote ou o instante da consulta.
+    int64_t inicio;             ///< Nanossegundos desde a ativação do rastreamento.
+    int64_t duracao;            ///< Nanossegundos.
+};
+
+/**
+ * @brief Rastreamento opcional de fases do processamento, exportado no formato de eventos do Chrome.
+ *
+ * @details Cada thread grava seus spans em um anel próprio, de capacidade fixa,
+ * criado na primeira gravação da thread: como só a dona escreve no anel, a
+ * gravação não usa travas nem operações atômicas de leitura-modificação-escrita,
+ * apenas uma publicação com semântica release do número de spans gravados.
+ * Quando o anel enche, os spans mais antigos são sobrescritos. A exportação lê
+ * todos os anéis e deve ocorrer depois que as threads rastreadas terminaram.
+ *
+ * Desativado (o padrão), um `EscopoRastreamento` custa uma leitura atômica
+ * relaxada. O arquivo exportado (`--trace`) abre no Perfetto ou em
+ * `chrome://tracing`, com uma linha do tempo por thread.
+ */
+class Rastreamento {
+public:
+    static const int CAPACIDADE_ANEL = 1 << 16; ///< Spans mantidos por thread.
+
+    /**
+     * @brief Ativa a gravação e define o instante zero da linha do tempo.
+     */
+    static void ativar();
+
+    /**
+     * @brief Indica se a gravação está ativa.
+     */
+    static bool ativo() {
+        return ativado.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Nanossegundos desde a ativação.
+     */
+    static int64_t agora();
+
+    /**
+     * @brief Grava um span no anel da thread atual.
+     */
+    static void registrar(const char* nome, int64_t inicio, int64_t fim, const char* nomeArgumento, long argumento);
+
+    /**
+     * @brief Dá um nome à thread atual na linha do tempo exportada (e.g., "leitor").
+     */
+    static void nomearThread(const std::string& nome);
+
+    /**
+     * @brief Escreve todos os spans gravados em `caminho`, no formato JSON de eventos do Chrome.
+     * @return `false` se o arquivo não puder ser escrito.
+     */
+    static bool exportar(const std::string& caminho);
+
+private:
+    static std::atomic<bool> ativado;
+};
+
+/**
+ * @brief Grava como span o tempo de vida do objeto, se o rastreamento estiver ativo.
+ *
+ * @code
+ * EscopoRastreamento escopo("processarConsultaCliente", "tempo", tempo);
+ * @endcode
+ */
+class EscopoRastreamento {
+public:
+    explicit EscopoRastreamento(const char* nome, const char* nomeArgumento = nullptr, long argumento = 0)
+        : nome(nome), nomeArgumento(nomeArgumento), argumento(argumento),
+          inicio(Rastreamento::ativo() ? Rastreamento::agora() : -1) {}
+
+    ~EscopoRastreamento() {
+        if (inicio >= 0) {
+            Rastreamento::registrar(nome, inicio, Rastreamento::agora(), nomeArgumento, argumento);
+        }
+    }
+
+    EscopoRastreamento(const EscopoRastreamento&) = delete;
+    EscopoRastreamento& operator=(const EscopoRastreamento&) = delete;
+
+private:
+    const char* nome;
+    const char* nomeArgumento;
+    long argumento;
+    int64_t inicio;
+};
+
+#endif // RASTREAMENTO_HPP
@@ -0,0 +1,87 @@
+#ifndef RELATORIO_MEMORIA_HPP
+#define RELATORIO_MEMORIA_HPP
+
+#include <ostream>
+#include <string>
+#include "Alocador.hpp"
+#include "Lista.hpp"
+
+/**
+ * @brief Retorna a memória apontada por um valor; tipos escalares não apontam para nada.
+ */
+template <typename T>
+UsoMemoria usoConteudo(const T&) {
+    return UsoMemoria();
+}
+
+/**
+ * @brief Retorna a memória de heap de uma string; strings curtas ficam no próprio objeto e não contam.
+ */
+inline UsoMemoria usoConteudo(const std::string& texto) {
+    const char* dados = texto.data();
+    const char* objeto = reinterpret_cast<const char*>(&texto);
+    if (dados >= objeto && dados < objeto + sizeof(std::string)) {
+        return UsoMemoria();
+    }
+    return UsoMemoria(texto.capacity() + 1, texto.size() + 1);
+}
+
+/**
+ * @brief Retorna a memória de um objeto alocado com `new`, inteiramente usada.
+ */
+template <typename T>
+UsoMemoria usoObjeto(const T*) {
+    return UsoMemoria(sizeof(T), sizeof(T));
+}
+
+/**
+ * @brief Contabilidade da memória de heap por estrutura, para o `--mem-report`.
+ *
+ * @details Cada amostra percorre as estruturas e registra, por componente, os
+ * bytes alocados, os usados e o número de elementos. O pico de cada componente
+ * é o maior valor alocado entre as amostras, não entre as alocações; o pico
+ * exato é o do total dos contêineres, dado por `ContadorAlocacoes`, e o do
+ * processo, dado pelo `VmHWM`.
+ *
+ * Os componentes aparecem no relatório na ordem do primeiro registro.
+ */
+class RelatorioMemoria {
+public:
+    /**
+     * @brief Zera os valores atuais de todos os componentes, mantendo os picos.
+     */
+    void iniciarAmostra();
+
+    /**
+     * @brief Soma `uso` e `elementos` aos valores atuais do componente.
+     */
+    void registrar(const char* componente, const UsoMemoria& uso, long elementos);
+
+    /**
+     * @brief Atualiza o pico de cada componente com os valores da amostra.
+     */
+    void concluirAmostra();
+
+    /**
+     * @brief Escreve a última amostra, os picos, o contador dos contêineres e a memória residente.
+     * @param rotulo Identifica a amostra (e.g., "final" ou "line 65536").
+     */
+    void escrever(std::ostream& saida, const std::string& rotulo) const;
+
+    /**
+     * @brief Lê um campo em KiB de `/proc/self/status` (e.g., "VmHWM"), ou -1 se indisponível.
+     */
+    static long lerStatusProcesso(const char* campo);
+
+private:
+    struct Componente {
+        const char* nome;
+        UsoMemoria atual;
+        long elementos;
+        size_t pico;
+    };
+
+    Lista<Componente> componentes;
+};
+
+#endif // RELATORIO_MEMORIA_HPP
@@ -0,0 +1,139 @@
+#ifndef SEGMENTO_DISCO_HPP
+#define SEGMENTO_DISCO_HPP
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include "Evento.hpp"
+#include "HistoricoPacote.hpp"
+#include "Lista.hpp"
+
+/**
+ * @brief Segmento imutável de eventos em disco, agrupados por pacote.
+ *
+ * @details O arquivo contém, nesta ordem:
+ *  - um cabeçalho com as contagens por tipo e o intervalo de tempo dos eventos;
+ *  - os históricos codificados dos pacotes, no formato de `VisaoHistorico`;
+ *  - um diretório com uma entrada por pacote, ordenado por ID;
+ *  - os marcadores do índice de saltos de todos os históricos;
+ *  - os timestamps dos eventos agrupados por tipo e ordenados, que permitem
+ *    responder a CE por busca binária.
+ *
+ * O arquivo é mapeado em memória (`mmap`) e só um índice esparso fica
+ * residente: o ID do pacote a cada `PASSO_INDICE` entradas do diretório, que
+ * localiza por busca binária o trecho onde está a entrada de um pacote.
+ */
+class SegmentoDisco {
+public:
+    static const int PASSO_INDICE = 64; ///< Entradas do diretório por entrada do índice esparso.
+
+    /**
+     * @brief Grava um segmento com históricos mantidos em memória, sem recodificá-los.
+     * @param caminho O arquivo a ser criado.
+     * @param ids Os IDs dos pacotes, em ordem crescente.
+     * @param historicos O histórico de cada pacote de `ids`.
+     * @return `false` se o arquivo não puder ser escrito.
+     */
+    static bool gravar(const std::string& caminho, const Lista<int>& ids,
+                       const Lista<VisaoHistorico>& historicos);
+
+    /**
+     * @brief Grava a intercalação de vários segmentos em um único segmento.
+     *
+     * Os históricos de um mesmo pacote são unidos em ordem de tempo, com os
+     * eventos dos segmentos mais antigos primeiro nos empates; por isso os
+     * segmentos de origem devem estar em ordem cronológica.
+     *
+     * @return `false` se o arquivo não puder ser escrito.
+     */
+    static bool mesclar(const std::string& caminho, SegmentoDisco* const* segmentos, int quantidade);
+
+    /**
+     * @brief Abre e mapeia um segmento gravado.
+     * @return O segmento, ou `nullptr` se o arquivo não existir ou for inválido.
+     */
+    static SegmentoDisco* abrir(const std::string& caminho);
+
+    /**
+     * @brief Desfaz o mapeamento e, se marcado com `descartarAoFechar`, apaga o arquivo.
+     */
+    ~SegmentoDisco();
+
+    SegmentoDisco(const SegmentoDisco&) = delete;
+    SegmentoDisco& operator=(const SegmentoDisco&) = delete;
+
+    /**
+     * @brief Localiza o histórico de um pacote.
+     * @return O histórico, ou uma visão vazia se o pacote não estiver no segmento.
+     */
+    VisaoHistorico buscarPacote(int idPacote) const;
+
+    /**
+     * @brief Soma a `contagens` os eventos de cada tipo com timestamp até `tempo`.
+     */
+    void contarEventos(int tempo, long* contagens) const;
+
+    // Acesso pela posição no diretório, em ordem de ID, usado pela mescla.
+    VisaoHistorico historico(int entrada) const;
+    int idPacote(int entrada) const { return diretorio[entrada].idPacote; }
+    int getQuantidadeTipo(int tipo) const { return static_cast<int>(cabecalho->contagens[tipo]); }
+    int tempoTipo(int tipo, int indice) const { return tempos[tipo][indice]; }
+
+    int getQuantidade() const { return static_cast<int>(cabecalho->quantidadeEventos); }
+    int getQuantidadePacotes() const { return static_cast<int>(cabecalho->quantidadePacotes); }
+    const std::string& getCaminho() const { return caminho; }
+
+    /**
+     * @brief Marca o arquivo para ser apagado quando o segmento for fechado.
+     */
+    void descartarAoFechar() { descartar = true; }
+
+private:
+    struct Cabecalho {
+        char magica[4];
+        uint32_t versao;
+        uint32_t quantidadePacotes;
+        uint32_t quantidadeEventos;
+        uint32_t quantidadeMarcadores;
+        uint32_t tamanhoDados;     ///< Bytes dos históricos codificados.
+        uint32_t deslocamentoDiretorio;
+        int32_t tempoMinimo;
+        int32_t tempoMaximo;
+        uint32_t contagens[INDEFINIDO + 1]; ///< Eventos por tipo.
+    };
+
+    struct Entrada {
+        int32_t idPacote;
+        int32_t quantidade;        ///< Eventos do pacote.
+        int32_t registros;         ///< Eventos RG do pacote.
+        uint32_t primeiroMarcador; ///< Índice do primeiro marcador do pacote.
+        uint32_t deslocamento;     ///< Início do histórico na área de dados.
+        uint32_t tamanho;          ///< Bytes do histórico.
+    };
+
+    /**
+     * @brief Escreve os históricos entregues por uma fonte e depois o diretório, os marcadores e os timestamps.
+     *
+     * `Fonte` entrega os pacotes em ordem de ID por meio de
+     * `proximoPacote(int&, VisaoHistorico&)` e os timestamps de cada tipo, já
+     * ordenados, por meio de `reiniciarTempos(int)` e `proximoTempo(int&)`.
+     */
+    template <typename Fonte>
+    static bool escrever(const std::string& caminho, Fonte& fonte);
+
+    std::string caminho;
+    int descritor;
+    void* mapa;
+    size_t tamanhoMapa;
+    const Cabecalho* cabecalho;
+    const unsigned char* dados;
+    const Entrada* diretorio;
+    const MarcadorHistorico* marcadores;
+    const int32_t* tempos[INDEFINIDO + 1]; ///< Timestamps ordenados de cada tipo.
+    Lista<int> indiceEsparso; ///< ID do pacote no início de cada bloco de `PASSO_INDICE` entradas.
+    bool descartar;
+
+    SegmentoDisco();
+};
+
+#endif // SEGMENTO_DISCO_HPP
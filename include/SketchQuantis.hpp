@@ -0,0 +1,112 @@
+#ifndef SKETCH_QUANTIS_HPP
+#define SKETCH_QUANTIS_HPP
+
+#include <cmath>
+#include "Lista.hpp"
+
+/**
+ * @brief Estimador de quantis em fluxo com erro relativo limitado.
+ *
+ * @details Valores positivos são contados em baldes de largura logarítmica:
+ * o balde `i` cobre o intervalo `(gamma^(i-1), gamma^i]`, com
+ * `gamma = (1 + alfa) / (1 - alfa)`. Qualquer quantil é então estimado com erro
+ * relativo de no máximo `alfa`, usando memória proporcional a log(máximo) e
+ * custo O(1) por inserção. Valores nulos ou negativos são contados à parte.
+ */
+class SketchQuantis {
+private:
+    Lista<long> baldes;     ///< Contagem por balde logarítmico.
+    long contagemZero;      ///< Quantidade de valores menores ou iguais a zero.
+    long total;             ///< Quantidade total de valores inseridos.
+    double gamma;
+    double logGamma;
+
+    double valorDoBalde(int indice) const {
+        return 2.0 * std::pow(gamma, indice) / (gamma + 1.0);
+    }
+
+public:
+    /**
+     * @brief Construtor.
+     * @param alfa O erro relativo máximo das estimativas (e.g., 0.01 para 1%).
+     */
+    explicit SketchQuantis(double alfa = 0.01) : contagemZero(0), total(0) {
+        gamma = (1.0 + alfa) / (1.0 - alfa);
+        logGamma = std::log(gamma);
+    }
+
+    /**
+     * @brief Insere um valor no sketch.
+     * @param valor O valor observado.
+     */
+    void adicionar(int valor) {
+        total++;
+        if (valor <= 0) {
+            contagemZero++;
+            return;
+        }
+        int indice = static_cast<int>(std::ceil(std::log(static_cast<double>(valor)) / logGamma));
+        if (indice >= baldes.getTamanho()) {
+            baldes.resize(indice + 1);
+        }
+        baldes[indice]++;
+    }
+
+    /**
+     * @brief Estima o quantil `q` dos valores inseridos.
+     * @param q O quantil desejado, entre 0 e 1 (e.g., 0.9 para o percentil 90).
+     * @return A estimativa do quantil, ou 0 se o sketch estiver vazio.
+     */
+    double quantil(double q) const {
+        if (total == 0) {
+            return 0.0;
+        }
+        long posicao = static_cast<long>(q * static_cast<double>(total - 1));
+        long acumulado = contagemZero;
+        if (posicao < acumulado) {
+            return 0.0;
+        }
+        for (int i = 0; i < baldes.getTamanho(); ++i) {
+            acumulado += baldes[i];
+            if (posicao < acumulado) {
+                return valorDoBalde(i);
+            }
+        }
+        return valorDoBalde(baldes.getTamanho() - 1);
+    }
+
+    /**
+     * @brief Acumula neste sketch os valores de outro.
+     *
+     * Como os baldes são fixos para um dado `alfa`, a mescla é exata: o resultado
+     * é idêntico ao de um único sketch que tivesse recebido todos os valores.
+     *
+     * @param outro Um sketch construído com o mesmo `alfa`.
+     */
+    void mesclar(const SketchQuantis& outro) {
+        if (outro.baldes.getTamanho() > baldes.getTamanho()) {
+            baldes.resize(outro.baldes.getTamanho());
+        }
+        for (int i = 0; i < outro.baldes.getTamanho(); ++i) {
+            baldes[i] += outro.baldes[i];
+        }
+        contagemZero += outro.contagemZero;
+        total += outro.total;
+    }
+
+    /**
+     * @brief Retorna o número de valores inseridos.
+     */
+    long getTotal() const {
+        return total;
+    }
+
+    /**
+     * @brief Retorna a memória dos contadores dos baldes.
+     */
+    UsoMemoria getUsoMemoria() const {
+        return baldes.getUsoMemoria();
+    }
+};
+
+#endif // SKETCH_QUANTIS_HPP
@@ -0,0 +1,128 @@
+#ifndef VARREDURA_ESCALA_HPP
+#define VARREDURA_ESCALA_HPP
+
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include "Evento.hpp"
+#include "Lista.hpp"
+#include "MotorLogistico.hpp"
+
+/**
+ * @brief Parâmetros da varredura de escalabilidade (`--sweep`).
+ *
+ * Os valores-base são os da análise experimental do relatório; cada experimento
+ * varia um deles de `base` até `base * fatorMaximo`, mantendo os outros fixos.
+ */
+struct ParametrosVarredura {
+    int pacotes;       ///< Número de pacotes na carga base.
+    int clientes;      ///< Número de clientes na carga base.
+    int consultasCL;   ///< Número de consultas CL na carga base.
+    int consultasPC;   ///< Número de consultas PC na carga base.
+    int armazens;      ///< Número de armazéns da rede (fixo em todos os experimentos).
+    int pontos;        ///< Pontos por experimento, em progressão geométrica.
+    int fatorMaximo;   ///< Razão entre o último e o primeiro ponto.
+    int repeticoes;    ///< Execuções medidas por ponto; reporta-se a mediana.
+    int aquecimento;   ///< Execuções descartadas antes das medidas, por ponto.
+    uint64_t semente;  ///< Semente do gerador de cargas.
+    bool json;         ///< Se `true`, a saída é JSON; caso contrário, CSV.
+
+    ParametrosVarredura() : pacotes(1000), clientes(500), consultasCL(100), consultasPC(100), armazens(10),
+                            pontos(5), fatorMaximo(10), repeticoes(3), aquecimento(1), semente(1), json(false) {}
+};
+
+/**
+ * @brief Benchmark de escalabilidade que gera as cargas em memória e mede o `MotorLogistico`.
+ *
+ * @details Substitui o ciclo do notebook da análise experimental (gerar um
+ * arquivo com o genwkl3, rodar `--timed`, medir a memória do processo): cada
+ * ponto da grade é uma carga sintética com a mesma estrutura das entradas do
+ * gerador (registro, armazenamentos e trânsitos por uma rota de armazéns,
+ * entrega; consultas CL e PC em instantes aleatórios), criada diretamente como
+ * `Evento`s. Sem leitura de arquivo, interpretação de texto ou início de
+ * processo, as medidas refletem apenas o motor.
+ *
+ * Cada execução de um ponto cria um motor novo e tem duas fases medidas
+ * separadamente: a ingestão de todos os eventos e as consultas, cada uma
+ * cronometrada individualmente. Para cada ponto são reportadas a mediana das
+ * repetições (vazão de ingestão e de consultas), os percentis de latência de CL
+ * e PC sobre todas as repetições e o pico de memória residente do processo
+ * durante o ponto. Ao final, para cada experimento, o expoente `k` de
+ * `tempo ~ parâmetro^k` é estimado por mínimos quadrados em escala log-log.
+ */
+class VarreduraEscala {
+public:
+    /**
+     * @brief Construtor.
+     * @param parametros A grade e as cargas-base.
+     * @param opcoes Parâmetros dos motores medidos.
+     */
+    VarreduraEscala(const ParametrosVarredura& parametros, const OpcoesMotor& opcoes = OpcoesMotor());
+
+    /**
+     * @brief Executa todos os experimentos e escreve os resultados em `saida`.
+     *
+     * O progresso é escrito em stderr.
+     */
+    void executar(std::ostream& saida);
+
+private:
+    /**
+     * @brief Uma carga sintética: eventos em ordem de tempo e consultas.
+     */
+    struct Carga {
+        Lista<Evento> eventos;
+        Lista<int> temposCL;
+        Lista<std::string> clientesCL;
+        Lista<int> temposPC;
+        Lista<int> pacotesPC;
+    };
+
+    /**
+     * @brief O resultado medido de um ponto da grade.
+     */
+    struct Ponto {
+        int experimento;  ///< Índice em `NOMES_EXPERIMENTOS`.
+        int pacotes;
+        int clientes;
+        int consultasCL;
+        int consultasPC;
+        int eventos;
+        double msIngestao;   ///< Mediana das repetições.
+        double msConsultas;  ///< Mediana das repetições.
+        double latenciaCL[3]; ///< p50, p95 e p99, em microssegundos.
+        double latenciaPC[3]; ///< p50, p95 e p99, em microssegundos.
+        long picoRssKiB;     ///< Pico de memória residente durante o ponto (`VmHWM`), ou -1 se indisponível.
+    };
+
+    ParametrosVarredura parametros;
+    OpcoesMotor opcoes;
+    Lista<Ponto> pontos;
+
+    /**
+     * @brief Gera uma carga com a mesma estrutura das entradas do genwkl3.
+     */
+    void gerarCarga(int pacotes, int clientes, int consultasCL, int consultasPC, uint64_t semente,
+                    Carga& carga) const;
+
+    /**
+     * @brief Executa as repetições de um ponto e registra o resultado.
+     */
+    void medirPonto(int experimento, int pacotes, int clientes, int consultasCL, int consultasPC);
+
+    /**
+     * @brief Estima o expoente `k` de `y ~ x^k` por mínimos quadrados sobre `(log x, log y)`.
+     * @return O expoente, ou 0 se houver menos de dois pontos distintos.
+     */
+    static double ajustarExpoente(const Lista<double>& x, const Lista<double>& y);
+
+    /**
+     * @brief Ajusta os expoentes de ingestão e de consultas aos pontos de um experimento.
+     */
+    void ajustarExperimento(int experimento, double& expoenteIngestao, double& expoenteConsultas) const;
+
+    void escreverCsv(std::ostream& saida) const;
+    void escreverJson(std::ostream& saida) const;
+};
+
+#endif // VARREDURA_ESCALA_HPP
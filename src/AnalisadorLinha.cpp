@@ -0,0 +1,268 @@
+#include "../include/AnalisadorLinha.hpp"
+#include <cstring>
+#include <sstream>
+#include <stdint.h>
+
+/**
+ * @file AnalisadorLinha.cpp
+ * @brief Implementação dos caminhos rápido (SWAR) e geral de interpretação de linhas.
+ */
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ANALISADOR_SWAR 1
+#endif
+
+TipoEvento AnalisadorLinha::tipoEvento(const char* p) {
+    switch (codigo(p[0], p[1])) {
+        case codigo('R', 'G'): return RG;
+        case codigo('A', 'R'): return AR;
+        case codigo('R', 'M'): return RM;
+        case codigo('U', 'R'): return UR;
+        case codigo('T', 'R'): return TR;
+        case codigo('E', 'N'): return EN;
+        default: return INDEFINIDO;
+    }
+}
+
+TipoEvento AnalisadorLinha::stringParaTipoEvento(const std::string& s) {
+    if (s.size() != 2) return INDEFINIDO;
+    return tipoEvento(s.data());
+}
+
+bool AnalisadorLinha::lerSeteDigitos(const char* p, int& valor) {
+#ifdef ANALISADOR_SWAR
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    // Descarta o 8º byte e insere um '0' à esquerda, formando 8 dígitos.
+    v = (v << 8) | 0x30;
+
+    // Todos os bytes devem estar entre '0' (0x30) e '9' (0x39).
+    if (((v & 0xF0F0F0F0F0F0F0F0ULL) |
+         (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) != 0x3333333333333333ULL) {
+        return false;
+    }
+
+    // Combina pares de dígitos, depois pares de pares, depois as duas metades.
+    v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    valor = static_cast<int>(((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+    return true;
+#else
+    int resultado = 0;
+    for (int i = 0; i < 7; ++i) {
+        if (p[i] < '0' || p[i] > '9') return false;
+        resultado = resultado * 10 + (p[i] - '0');
+    }
+    valor = resultado;
+    return true;
+#endif
+}
+
+bool AnalisadorLinha::lerTresDigitos(const char* p, int& valor) {
+#ifdef ANALISADOR_SWAR
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    v = (v << 8) | 0x30;
+
+    if (((v & 0xF0F0F0F0u) | (((v + 0x06060606u) & 0xF0F0F0F0u) >> 4)) != 0x33333333u) {
+        return false;
+    }
+
+    v = ((v & 0x0F0F0F0Fu) * 2561u) >> 8;
+    v = ((v & 0x00FF00FFu) * 6553601u) >> 16;
+    valor = static_cast<int>(v & 0xFFFFu);
+    return true;
+#else
+    int resultado = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (p[i] < '0' || p[i] > '9') return false;
+        resultado = resultado * 10 + (p[i] - '0');
+    }
+    valor = resultado;
+    return true;
+#endif
+}
+
+bool AnalisadorLinha::analisarCabecalho(const std::string& linha, int& dataHora, int& comando) {
+    const char* p = linha.c_str();
+    size_t n = linha.size();
+    if (n < 10 || p[7] != ' ' || (n > 10 && p[10] != ' ')) {
+        return false;
+    }
+    if (!lerSeteDigitos(p, dataHora)) {
+        return false;
+    }
+    comando = codigo(p[8], p[9]);
+    return true;
+}
+
+/**
+ * @brief Lê um campo " NNN" na posição `pos` e avança `pos` até o fim dele.
+ *
+ * O campo deve ser seguido de espaço ou do fim da linha. Como `std::string`
+ * garante o terminador nulo, os 4 bytes lidos a partir dos dígitos são válidos.
+ */
+static bool lerCampoTresDigitos(const char* p, size_t n, size_t& pos, int& valor) {
+    if (pos + 4 > n || p[pos] != ' ') return false;
+    if (pos + 4 < n && p[pos + 4] != ' ') return false;
+    if (!AnalisadorLinha::lerTresDigitos(p + pos + 1, valor)) return false;
+    pos += 4;
+    return true;
+}
+
+/**
+ * @brief Lê um campo " NOME" na posição `pos` e avança `pos` até o fim dele.
+ */
+static bool lerCampoNome(const char* p, size_t n, size_t& pos, std::string& nome) {
+    if (pos >= n || p[pos] != ' ') return false;
+    const char* inicio = p + pos + 1;
+    const char* fim = static_cast<const char*>(std::memchr(inicio, ' ', n - pos - 1));
+    if (fim == nullptr) fim = p + n;
+    if (fim == inicio) return false;
+    nome.assign(inicio, fim - inicio);
+    pos = fim - p;
+    return true;
+}
+
+bool AnalisadorLinha::analisarEventoRapido(const std::string& linha, Evento& ev) {
+    const char* p = linha.c_str();
+    size_t n = linha.size();
+
+    // Cada tipo preenche só os seus campos; os demais não podem vir de uma linha anterior.
+    ev = Evento();
+
+    // "TTTTTTT EV XX NNN" tem 17 caracteres.
+    int comando;
+    if (n < 17 || !analisarCabecalho(linha, ev.dataHora, comando) || comando != codigo('E', 'V')) {
+        return false;
+    }
+    if (p[13] != ' ') return false;
+    ev.tipo = tipoEvento(p + 11);
+    if (ev.tipo == INDEFINIDO) return false;
+
+    size_t pos = 13;
+    if (!lerCampoTresDigitos(p, n, pos, ev.idPacote)) return false;
+
+    bool ok = false;
+    switch (ev.tipo) {
+        case RG:
+            ok = lerCampoNome(p, n, pos, ev.remetente) &&
+                 lerCampoNome(p, n, pos, ev.destinatario) &&
+                 lerCampoTresDigitos(p, n, pos, ev.armazemOrigem) &&
+                 lerCampoTresDigitos(p, n, pos, ev.armazemDestino);
+            break;
+        case AR:
+        case RM:
+        case UR:
+            ok = lerCampoTresDigitos(p, n, pos, ev.armazemOrigem) &&
+                 lerCampoTresDigitos(p, n, pos, ev.secaoDestino);
+            break;
+        case TR:
+            ok = lerCampoTresDigitos(p, n, pos, ev.armazemOrigem) &&
+                 lerCampoTresDigitos(p, n, pos, ev.armazemDestino);
+            break;
+        case EN:
+            ok = lerCampoTresDigitos(p, n, pos, ev.armazemDestino);
+            break;
+        case INDEFINIDO:
+            break;
+    }
+    return ok && pos == n;
+}
+
+bool AnalisadorLinha::analisarCamposEvento(std::istream& ss, Evento& ev) {
+    std::string tipoEventoStr;
+    ss >> tipoEventoStr >> ev.idPacote;
+    ev.tipo = stringParaTipoEvento(tipoEventoStr);
+
+    switch (ev.tipo) {
+        case RG: ss >> ev.remetente >> ev.destinatario >> ev.armazemOrigem >> ev.armazemDestino; break;
+        case AR: ss >> ev.armazemOrigem >> ev.secaoDestino; break;
+        case RM: ss >> ev.armazemOrigem >> ev.secaoDestino; break;
+        case UR: ss >> ev.armazemOrigem >> ev.secaoDestino; break;
+        case TR: ss >> ev.armazemOrigem >> ev.armazemDestino; break;
+        case EN: ss >> ev.armazemDestino; break;
+        case INDEFINIDO: return false; // Ignora evento inválido
+    }
+    return true;
+}
+
+bool AnalisadorLinha::analisarEventoGeral(const std::string& linha, Evento& ev) {
+    std::stringstream ss(linha);
+    std::string tipoComando;
+    ev = Evento();
+    ss >> ev.dataHora >> tipoComando;
+    if (tipoComando != "EV") {
+        return false;
+    }
+    return analisarCamposEvento(ss, ev);
+}
+
+bool AnalisadorLinha::analisarLinha(const std::string& linha, Comando& comando) {
+    // Caminho rápido: linhas no layout fixo são decodificadas sem stringstream.
+    int codigoComando;
+    if (analisarCabecalho(linha, comando.dataHora, codigoComando)) {
+        if (codigoComando == codigo('E', 'V')) {
+            if (analisarEventoRapido(linha, comando.evento)) {
+                comando.tipo = COMANDO_EVENTO;
+                return true;
+            }
+        } else if (codigoComando == codigo('P', 'C') && linha.size() == 14) {
+            if (lerTresDigitos(linha.c_str() + 11, comando.idPacote)) {
+                comando.tipo = COMANDO_PACOTE;
+                return true;
+            }
+        } else if (codigoComando == codigo('C', 'L') && linha.size() > 11 &&
+                   linha.find_first_of(" \t\r", 11) == std::string::npos) {
+            comando.texto.assign(linha, 11, std::string::npos);
+            comando.tipo = COMANDO_CLIENTE;
+            return true;
+        }
+    }
+
+    // Caminho geral, para linhas fora do layout fixo e para os demais comandos.
+    std::stringstream ss(linha);
+    std::string tipoComando;
+    ss >> comando.dataHora >> tipoComando;
+
+    comando.tipo = COMANDO_INVALIDO;
+    if (tipoComando == "EV") {
+        comando.evento = Evento();
+        comando.evento.dataHora = comando.dataHora;
+        if (analisarCamposEvento(ss, comando.evento)) {
+            comando.tipo = COMANDO_EVENTO;
+        }
+    } else if (tipoComando == "CL") {
+        ss >> comando.texto;
+        comando.tipo = COMANDO_CLIENTE;
+    } else if (tipoComando == "PC") {
+        ss >> comando.idPacote;
+        comando.tipo = COMANDO_PACOTE;
+    } else if (tipoComando == "RK") {
+        ss >> comando.texto >> comando.parametro1;
+        comando.tipo = COMANDO_RANKING;
+    } else if (tipoComando == "RT") {
+        ss >> comando.idPacote;
+        comando.tipo = COMANDO_ROTA;
+    } else if (tipoComando == "LA") {
+        ss >> comando.parametro1 >> comando.parametro2;
+        comando.tipo = COMANDO_TRECHO;
+    } else if (tipoComando == "CE") {
+        comando.tipo = COMANDO_CONTAGEM;
+    } else if (tipoComando == "AS" || tipoComando == "CA") {
+        std::string alvo;
+        ss >> alvo;
+        bool valido = false;
+        if (alvo == "CL") {
+            valido = static_cast<bool>(ss >> comando.texto);
+            comando.parametro1 = ASSINATURA_CLIENTE;
+        } else if (alvo == "PC") {
+            valido = static_cast<bool>(ss >> comando.idPacote);
+            comando.parametro1 = ASSINATURA_PACOTE;
+        }
+        if (valido) {
+            comando.tipo = tipoComando == "AS" ? COMANDO_ASSINATURA : COMANDO_CANCELAMENTO;
+        }
+    }
+    return comando.tipo != COMANDO_INVALIDO;
+}
@@ -0,0 +1,91 @@
+#include "../include/BufferReordenacao.hpp"
+
+/**
+ * @file BufferReordenacao.cpp
+ * @brief Implementação da classe BufferReordenacao.
+ */
+
+BufferReordenacao::BufferReordenacao(int atrasoMaximo)
+    : atrasoMaximo(atrasoMaximo), maiorTempo(0), recebeuEvento(false), encerrado(false),
+      proximaSequencia(0), descartados(0) {}
+
+bool BufferReordenacao::inserir(const Comando& comando) {
+    if (comando.tipo == COMANDO_EVENTO) {
+        if (recebeuEvento && comando.dataHora < maiorTempo - atrasoMaximo) {
+            descartados++;
+            return false;
+        }
+        if (!recebeuEvento || comando.dataHora > maiorTempo) {
+            maiorTempo = comando.dataHora;
+        }
+        recebeuEvento = true;
+    }
+
+    heap.adicionar({comando, proximaSequencia++});
+    subir(heap.getTamanho() - 1);
+    return true;
+}
+
+bool BufferReordenacao::liberado(const Entrada& entrada) const {
+    if (encerrado) {
+        return true;
+    }
+    return recebeuEvento && entrada.comando.dataHora <= maiorTempo - atrasoMaximo;
+}
+
+bool BufferReordenacao::extrair(Comando& comando) {
+    if (heap.getTamanho() == 0 || !liberado(heap.obter(0))) {
+        return false;
+    }
+
+    comando = heap.obter(0).comando;
+    int ultimo = heap.getTamanho() - 1;
+    if (ultimo > 0) {
+        heap.definir(0, heap.obter(ultimo));
+    }
+    heap.resize(ultimo);
+    descer(0);
+    return true;
+}
+
+void BufferReordenacao::encerrar() {
+    encerrado = true;
+}
+
+bool BufferReordenacao::precede(const Entrada& a, const Entrada& b) {
+    if (a.comando.dataHora != b.comando.dataHora) {
+        return a.comando.dataHora < b.comando.dataHora;
+    }
+    return a.sequencia < b.sequencia;
+}
+
+void BufferReordenacao::subir(int indice) {
+    while (indice > 0) {
+        int pai = (indice - 1) / 2;
+        if (!precede(heap.obter(indice), heap.obter(pai))) {
+            break;
+        }
+        Entrada temp = heap.obter(indice);
+        heap.definir(indice, heap.obter(pai));
+        heap.definir(pai, temp);
+        indice = pai;
+    }
+}
+
+void BufferReordenacao::descer(int indice) {
+    int n = heap.getTamanho();
+    while (true) {
+        int menor = indice;
+        int esquerda = 2 * indice + 1;
+        int direita = esquerda + 1;
+        if (esquerda < n && precede(heap.obter(esquerda), heap.obter(menor))) menor = esquerda;
+        if (direita < n && precede(heap.obter(direita), heap.obter(menor))) menor = direita;
+        if (menor == indice) {
+            break;
+        }
+        Entrada temp = heap.obter(indice);
+        heap.definir(indice, heap.obter(menor));
+        heap.definir(menor, temp);
+        indice = menor;
+    }
+}
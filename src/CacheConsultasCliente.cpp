@@ -0,0 +1,121 @@
+#include "../include/CacheConsultasCliente.hpp"
+#include "../include/RelatorioMemoria.hpp"
+
+/**
+ * @file CacheConsultasCliente.cpp
+ * @brief Implementação da classe CacheConsultasCliente.
+ */
+
+CacheConsultasCliente::CacheConsultasCliente(size_t limiteBytes)
+    : maisRecente(nullptr), menosRecente(nullptr), limiteBytes(limiteBytes),
+      bytesUsados(0), acertos(0), falhas(0) {}
+
+CacheConsultasCliente::~CacheConsultasCliente() {
+    Entrada* entrada = maisRecente;
+    while (entrada != nullptr) {
+        Entrada* proxima = entrada->proxima;
+        delete entrada;
+        entrada = proxima;
+    }
+}
+
+size_t CacheConsultasCliente::custo(const Entrada* entrada) {
+    return sizeof(Entrada) + entrada->nomeCliente.size() + entrada->corpo.size();
+}
+
+bool CacheConsultasCliente::valida(const Entrada* entrada, int tempo, const VersaoCliente& versao) {
+    if (entrada->versao.versao != versao.versao) {
+        return false;
+    }
+    // Sem eventos novos, a resposta só muda com o instante se algum evento do
+    // cliente ficar entre o instante guardado e o consultado.
+    return entrada->tempo == tempo ||
+           (versao.ultimoTempo <= entrada->tempo && versao.ultimoTempo <= tempo);
+}
+
+void CacheConsultasCliente::desvincular(Entrada* entrada) {
+    if (entrada->anterior != nullptr) {
+        entrada->anterior->proxima = entrada->proxima;
+    } else {
+        maisRecente = entrada->proxima;
+    }
+    if (entrada->proxima != nullptr) {
+        entrada->proxima->anterior = entrada->anterior;
+    } else {
+        menosRecente = entrada->anterior;
+    }
+}
+
+void CacheConsultasCliente::vincularNoInicio(Entrada* entrada) {
+    entrada->anterior = nullptr;
+    entrada->proxima = maisRecente;
+    if (maisRecente != nullptr) {
+        maisRecente->anterior = entrada;
+    } else {
+        menosRecente = entrada;
+    }
+    maisRecente = entrada;
+}
+
+void CacheConsultasCliente::descartar(Entrada* entrada) {
+    desvincular(entrada);
+    entradas.remover(entrada->nomeCliente);
+    bytesUsados -= custo(entrada);
+    delete entrada;
+}
+
+const std::string* CacheConsultasCliente::buscar(const std::string& nomeCliente, int tempo,
+                                                 const VersaoCliente& versao) {
+    Entrada* entrada = entradas.buscar(nomeCliente);
+    if (entrada == nullptr) {
+        falhas++;
+        return nullptr;
+    }
+    if (!valida(entrada, tempo, versao)) {
+        descartar(entrada);
+        falhas++;
+        return nullptr;
+    }
+
+    desvincular(entrada);
+    vincularNoInicio(entrada);
+    acertos++;
+    return &entrada->corpo;
+}
+
+void CacheConsultasCliente::armazenar(const std::string& nomeCliente, int tempo,
+                                      const VersaoCliente& versao, const std::string& corpo) {
+    Entrada* antiga = entradas.buscar(nomeCliente);
+    if (antiga != nullptr) {
+        descartar(antiga);
+    }
+
+    Entrada* entrada = new Entrada();
+    entrada->nomeCliente = nomeCliente;
+    entrada->tempo = tempo;
+    entrada->versao = versao;
+    entrada->corpo = corpo;
+    size_t tamanho = custo(entrada);
+    if (tamanho > limiteBytes) {
+        delete entrada;
+        return;
+    }
+
+    while (bytesUsados + tamanho > limiteBytes) {
+        descartar(menosRecente);
+    }
+    entradas.inserir(nomeCliente, entrada);
+    vincularNoInicio(entrada);
+    bytesUsados += tamanho;
+}
+
+UsoMemoria CacheConsultasCliente::getUsoMemoria() const {
+    UsoMemoria uso = entradas.getUsoMemoria();
+    for (const Entrada* entrada = maisRecente; entrada != nullptr; entrada = entrada->proxima) {
+        uso += usoConteudo(entrada->nomeCliente); // a chave do mapa é uma cópia do nome
+        uso += usoObjeto(entrada);
+        uso += usoConteudo(entrada->nomeCliente);
+        uso += usoConteudo(entrada->corpo);
+    }
+    return uso;
+}
@@ -1,7 +1,12 @@
 #include "../include/Carregamento.hpp"
+#include "../include/FilaSPSC.hpp"
+#include "../include/FormatadorSaida.hpp"
+#include "../include/ExecutorParticionado.hpp"
+#include "../include/BufferReordenacao.hpp"
+#include "../include/Rastreamento.hpp"
 #include <fstream>
 #include <sstream>
-#include <iomanip> // Para std::setw e std::setfill
+#include <thread>
 #include <chrono>  // Para medição de tempo
 
 /**
@@ -9,259 +14,494 @@
  * @brief Implementação da classe Carregamento.
  */
 
-Carregamento::Carregamento(const std::string& filename) : filename(filename) {
-    mapaPacotes = new Mapa<int, Lista<Evento*>*>();
-    mapaClientes = new Mapa<std::string, PacotesCliente*>();
+/// Memória padrão do cache de respostas da consulta CL.
+static const size_t LIMITE_CACHE_CLIENTES = 8 * 1024 * 1024;
+
+/// Linhas por span "processarLinha" no rastreamento dos modos sequenciais.
+static const int LINHAS_POR_SPAN = 1024;
+
+/// Linhas entre amostras de memória do `--mem-report`, que alimentam o pico de cada estrutura.
+static const long LINHAS_POR_AMOSTRA_MEMORIA = 65536;
+
+Carregamento::Carregamento(const std::string& filename, const OpcoesMotor& opcoes)
+    : filename(filename), opcoes(opcoes), linhasLidas(0), bytesLidos(0), relatorioMemoria(nullptr),
+      intervaloRelatorioMemoria(0) {
+    motor = new MotorLogistico(opcoes);
+    cacheClientes = new CacheConsultasCliente(LIMITE_CACHE_CLIENTES);
 }
 
 Carregamento::~Carregamento() {
-    // 1. Libera a memória de todos os objetos Evento.
-    for (int i = 0; i < eventos.getTamanho(); ++i) {
-        delete eventos.obter(i);
+    delete motor;
+    delete cacheClientes;
+    delete relatorioMemoria;
+}
+
+void Carregamento::configurarCacheClientes(size_t limiteBytes) {
+    delete cacheClientes;
+    cacheClientes = nullptr;
+    if (limiteBytes > 0) {
+        cacheClientes = new CacheConsultasCliente(limiteBytes);
     }
+}
 
-    // 2. Libera as listas de eventos dentro do mapa de pacotes.
-    Lista<Lista<Evento*>*> listasDeEventos = mapaPacotes->obterValores();
-    for (int i = 0; i < listasDeEventos.getTamanho(); ++i) {
-        delete listasDeEventos.obter(i);
+void Carregamento::configurarRelatorioMemoria(long intervaloLinhas) {
+    if (relatorioMemoria == nullptr) {
+        relatorioMemoria = new RelatorioMemoria();
     }
+    intervaloRelatorioMemoria = intervaloLinhas;
+}
 
-    // 3. Libera os objetos PacotesCliente dentro do mapa de clientes.
-    Lista<PacotesCliente*> listasDePacotes = mapaClientes->obterValores();
-    for (int i = 0; i < listasDePacotes.getTamanho(); ++i) {
-        delete listasDePacotes.obter(i);
+void Carregamento::amostrarMemoria(const Lista<std::string>* linhas, const std::string& rotulo, bool escrever,
+                                   const ExecutorParticionado* particionado) {
+    if (relatorioMemoria == nullptr) {
+        return;
     }
+    EscopoRastreamento escopo("amostrarMemoria");
+    relatorioMemoria->iniciarAmostra();
+    if (linhas != nullptr) {
+        UsoMemoria uso = linhas->getUsoMemoria();
+        for (const std::string& linha : *linhas) {
+            uso += usoConteudo(linha);
+        }
+        relatorioMemoria->registrar("input lines", uso, linhas->getTamanho());
+    }
+    if (particionado != nullptr) {
+        particionado->medirMemoria(*relatorioMemoria);
+    } else {
+        motor->medirMemoria(*relatorioMemoria);
+    }
+    if (cacheClientes != nullptr) {
+        relatorioMemoria->registrar("CL cache", cacheClientes->getUsoMemoria(),
+                                    static_cast<long>(cacheClientes->getQuantidadeEntradas()));
+    }
+    relatorioMemoria->concluirAmostra();
+    if (escrever) {
+        relatorioMemoria->escrever(std::cerr, rotulo);
+    }
+}
 
-    // 4. Libera os próprios mapas.
-    delete mapaPacotes;
-    delete mapaClientes;
+void Carregamento::acompanharMemoria(const Lista<std::string>* linhas, long anteriores, long processadas) {
+    if (relatorioMemoria == nullptr) {
+        return;
+    }
+    if (intervaloRelatorioMemoria > 0 &&
+        processadas / intervaloRelatorioMemoria != anteriores / intervaloRelatorioMemoria) {
+        amostrarMemoria(linhas, "line " + std::to_string(processadas), true);
+    } else if (processadas / LINHAS_POR_AMOSTRA_MEMORIA != anteriores / LINHAS_POR_AMOSTRA_MEMORIA) {
+        amostrarMemoria(linhas, "", false);
+    }
 }
 
-void Carregamento::executar() {
+bool Carregamento::carregarLinhas(Lista<std::string>& linhas) {
+    EscopoRastreamento escopo("carregarLinhas");
     std::ifstream inputFile(this->filename);
     if (!inputFile.is_open()) {
         std::cerr << "Erro ao abrir o arquivo: " << this->filename << std::endl;
-        return;
+        return false;
     }
 
-    // Carrega todas as linhas para a memória primeiro
-    Lista<std::string> linhas;
     std::string linha;
+    linhasLidas = 0;
+    bytesLidos = 0;
     while (std::getline(inputFile, linha)) {
         if (!linha.empty()) {
+            bytesLidos += static_cast<long>(linha.size()) + 1;
             linhas.adicionar(linha);
         }
     }
+    linhasLidas = linhas.getTamanho();
     inputFile.close();
+    return true;
+}
+
+void Carregamento::executar() {
+    executar(std::cout);
+}
+
+bool Carregamento::executar(std::ostream& saida) {
+    // Carrega todas as linhas para a memória primeiro
+    Lista<std::string> linhas;
+    if (!carregarLinhas(linhas)) {
+        return false;
+    }
 
     // Agora, processa as linhas a partir da memória
-    for (int i = 0; i < linhas.getTamanho(); ++i) {
-        processarLinha(linhas.obter(i));
+    processarLinhas(linhas, saida);
+    {
+        EscopoRastreamento escopo("flush");
+        saida.flush();
     }
+    amostrarMemoria(&linhas, "final", true);
+    return true;
 }
 
-void Carregamento::processarLinha(const std::string& linha) {
-    std::stringstream ss(linha);
-    int dataHora;
-    std::string tipoComando;
-    ss >> dataHora >> tipoComando;
-
-    if (tipoComando == "EV") {
-        Evento* ev = new Evento();
-        ev->dataHora = dataHora;
-        std::string tipoEventoStr;
-        ss >> tipoEventoStr >> ev->idPacote;
-        ev->tipo = stringParaTipoEvento(tipoEventoStr);
-
-        switch (ev->tipo) {
-            case RG: {
-                ss >> ev->remetente >> ev->destinatario >> ev->armazemOrigem >> ev->armazemDestino;
-                
-                // Processa remetente
-                PacotesCliente* pacotesRemetente = mapaClientes->buscar(ev->remetente);
-                if (pacotesRemetente == nullptr) {
-                    pacotesRemetente = new PacotesCliente();
-                    mapaClientes->inserir(ev->remetente, pacotesRemetente);
-                }
-                if (!pacotesRemetente->enviados.contem(ev->idPacote)) {
-                    pacotesRemetente->enviados.adicionar(ev->idPacote);
-                }
-
-                // Processa destinatário
-                PacotesCliente* pacotesDestinatario = mapaClientes->buscar(ev->destinatario);
-                if (pacotesDestinatario == nullptr) {
-                    pacotesDestinatario = new PacotesCliente();
-                    mapaClientes->inserir(ev->destinatario, pacotesDestinatario);
-                }
-                if (!pacotesDestinatario->aReceber.contem(ev->idPacote)) {
-                    pacotesDestinatario->aReceber.adicionar(ev->idPacote);
-                }
-                break;
-            }
-            case AR: ss >> ev->armazemOrigem >> ev->secaoDestino; break;
-            case RM: ss >> ev->armazemOrigem >> ev->secaoDestino; break;
-            case UR: ss >> ev->armazemOrigem >> ev->secaoDestino; break;
-            case TR: ss >> ev->armazemOrigem >> ev->armazemDestino; break;
-            case EN: ss >> ev->armazemDestino; break;
-            case INDEFINIDO: delete ev; return; // Ignora evento inválido e libera memória
+void Carregamento::processarLinhas(const Lista<std::string>& linhas, std::ostream& saida) {
+    // Os spans agrupam as linhas em lotes, para que o custo do rastreamento não
+    // distorça a medida de linhas que levam menos de um microssegundo.
+    for (int inicio = 0; inicio < linhas.getTamanho(); inicio += LINHAS_POR_SPAN) {
+        EscopoRastreamento escopo("processarLinha", "primeiraLinha", inicio + 1);
+        int fim = inicio + LINHAS_POR_SPAN < linhas.getTamanho() ? inicio + LINHAS_POR_SPAN : linhas.getTamanho();
+        for (int i = inicio; i < fim; ++i) {
+            processarLinha(linhas[i], saida);
+            acompanharMemoria(&linhas, i, i + 1);
         }
+    }
+}
 
-        eventos.adicionar(ev);
-
-        Lista<Evento*>* listaEventosPacote = mapaPacotes->buscar(ev->idPacote);
-        if (listaEventosPacote == nullptr) {
-            listaEventosPacote = new Lista<Evento*>();
-            mapaPacotes->inserir(ev->idPacote, listaEventosPacote);
-        }
-        listaEventosPacote->adicionar(ev);
+void Carregamento::processarLinha(const std::string& linha, std::ostream& saida) {
+    Comando comando;
+    if (AnalisadorLinha::analisarLinha(linha, comando)) {
+        executarComando(comando, saida);
+    }
+}
 
-    } else if (tipoComando == "CL") {
-        std::string nomeCliente;
-        ss >> nomeCliente;
-        processarConsultaCliente(dataHora, nomeCliente);
-    } else if (tipoComando == "PC") {
-        int idPacote;
-        ss >> idPacote;
-        processarConsultaPacote(dataHora, idPacote);
+void Carregamento::executarComando(const Comando& comando, std::ostream& saida) {
+    switch (comando.tipo) {
+        case COMANDO_EVENTO:
+            motor->ingerir(comando.evento);
+            if (motor->temNotificacoes()) {
+                escreverNotificacoes(saida);
+            }
+            break;
+        case COMANDO_PACOTE:
+            processarConsultaPacote(comando.dataHora, comando.idPacote, saida);
+            break;
+        case COMANDO_CLIENTE:
+            processarConsultaCliente(comando.dataHora, comando.texto, saida);
+            break;
+        case COMANDO_RANKING:
+            processarConsultaRanking(comando.dataHora, comando.texto, comando.parametro1, saida);
+            break;
+        case COMANDO_ROTA:
+            processarConsultaRota(comando.dataHora, comando.idPacote, saida);
+            break;
+        case COMANDO_TRECHO:
+            processarConsultaTrecho(comando.dataHora, comando.parametro1, comando.parametro2, saida);
+            break;
+        case COMANDO_CONTAGEM:
+            processarConsultaContagem(comando.dataHora, saida);
+            break;
+        case COMANDO_ASSINATURA:
+            processarAssinatura(comando, saida);
+            break;
+        case COMANDO_CANCELAMENTO:
+            processarCancelamento(comando, saida);
+            break;
+        case COMANDO_INVALIDO:
+            break;
     }
 }
 
-void Carregamento::processarConsultaPacote(int tempo, int idPacote) {
-    std::cout << std::setw(6) << std::setfill('0') << tempo << " PC " << std::setw(3) << std::setfill('0') << idPacote << std::endl;
+void Carregamento::processarConsultaPacote(int tempo, int idPacote, std::ostream& saida) {
+    FormatadorSaida::escreverPacote(tempo, idPacote, motor->consultarPacote(tempo, idPacote), saida);
+}
 
-    Lista<Evento*>* todosEventos = mapaPacotes->buscar(idPacote);
-    if (todosEventos == nullptr) {
-        std::cout << 0 << std::endl;
+void Carregamento::processarConsultaCliente(int tempo, const std::string& nomeCliente, std::ostream& saida) {
+    EscopoRastreamento escopo("processarConsultaCliente", "tempo", tempo);
+    VersaoCliente versao;
+    if (cacheClientes == nullptr || !motor->obterVersaoCliente(nomeCliente, versao)) {
+        FormatadorSaida::escreverCliente(tempo, nomeCliente, motor->consultarCliente(tempo, nomeCliente), saida);
         return;
     }
 
-    Lista<Evento*> eventosFiltrados;
-    for (int i = 0; i < todosEventos->getTamanho(); ++i) {
-        Evento* ev = todosEventos->obter(i);
-        if (ev->getTempo() <= tempo) {
-            eventosFiltrados.adicionar(ev);
-        }
+    FormatadorSaida::escreverCabecalhoCliente(tempo, nomeCliente, saida);
+    const std::string* corpo = cacheClientes->buscar(nomeCliente, tempo, versao);
+    if (corpo != nullptr) {
+        saida << *corpo;
+        return;
     }
 
-    std::cout << eventosFiltrados.getTamanho() << std::endl;
-    for (int i = 0; i < eventosFiltrados.getTamanho(); ++i) {
-        eventosFiltrados.obter(i)->imprimir();
-    }
+    std::ostringstream texto;
+    FormatadorSaida::escreverEventos(motor->consultarCliente(tempo, nomeCliente), texto);
+    saida << texto.str();
+    cacheClientes->armazenar(nomeCliente, tempo, versao, texto.str());
 }
 
-void Carregamento::processarConsultaCliente(int tempo, const std::string& nomeCliente) {
-    std::cout << std::setw(6) << std::setfill('0') << tempo << " CL " << nomeCliente << std::endl;
+void Carregamento::processarConsultaRanking(int tempo, const std::string& categoria, int quantidade, std::ostream& saida) {
+    FormatadorSaida::escreverRanking(tempo, categoria, quantidade, motor->getRankings(), saida);
+}
 
-    PacotesCliente* pacotesCliente = mapaClientes->buscar(nomeCliente);
-    if (pacotesCliente == nullptr) {
-        std::cout << 0 << std::endl;
-        return;
-    }
+void Carregamento::processarConsultaRota(int tempo, int idPacote, std::ostream& saida) {
+    FormatadorSaida::escreverRota(tempo, idPacote, motor->consultarRota(tempo, idPacote), saida);
+}
+
+void Carregamento::processarConsultaTrecho(int tempo, int origem, int destino, std::ostream& saida) {
+    ResumoTrecho resumo;
+    bool encontrado = motor->consultarTrecho(origem, destino, resumo);
+    FormatadorSaida::escreverTrecho(tempo, origem, destino, encontrado ? &resumo : nullptr, saida);
+}
 
-    Lista<Evento*> eventosResultantes;
-    Lista<int> todosOsIds;
-    // Coleta IDs de pacotes enviados
-    for(int i = 0; i < pacotesCliente->enviados.getTamanho(); ++i) {
-        todosOsIds.adicionar(pacotesCliente->enviados.obter(i));
+void Carregamento::processarConsultaContagem(int tempo, std::ostream& saida) {
+    long contagens[INDEFINIDO + 1];
+    motor->contarEventos(tempo, contagens);
+    FormatadorSaida::escreverContagem(tempo, contagens, saida);
+}
+
+void Carregamento::processarAssinatura(const Comando& comando, std::ostream& saida) {
+    TipoAssinatura tipo = static_cast<TipoAssinatura>(comando.parametro1);
+    FormatadorSaida::escreverCabecalhoAssinatura(comando.dataHora, "AS", tipo, comando.texto, comando.idPacote, saida);
+    if (tipo == ASSINATURA_CLIENTE) {
+        motor->assinarCliente(comando.texto);
+        FormatadorSaida::escreverEventos(motor->consultarCliente(comando.dataHora, comando.texto), saida);
+    } else {
+        motor->assinarPacote(comando.idPacote);
+        FormatadorSaida::escreverEventos(motor->consultarPacote(comando.dataHora, comando.idPacote), saida);
     }
-    // Coleta IDs de pacotes a receber
-    for(int i = 0; i < pacotesCliente->aReceber.getTamanho(); ++i) {
-        int idPacote = pacotesCliente->aReceber.obter(i);
-        if (!todosOsIds.contem(idPacote)) { // Evita duplicatas
-            todosOsIds.adicionar(idPacote);
-        }
+}
+
+void Carregamento::processarCancelamento(const Comando& comando, std::ostream& saida) {
+    TipoAssinatura tipo = static_cast<TipoAssinatura>(comando.parametro1);
+    FormatadorSaida::escreverCabecalhoAssinatura(comando.dataHora, "CA", tipo, comando.texto, comando.idPacote, saida);
+    if (tipo == ASSINATURA_CLIENTE) {
+        motor->cancelarAssinaturaCliente(comando.texto);
+    } else {
+        motor->cancelarAssinaturaPacote(comando.idPacote);
     }
+}
 
-    for (int i = 0; i < todosOsIds.getTamanho(); ++i) {
-        int idPacote = todosOsIds.obter(i);
-        Lista<Evento*>* eventosPacote = mapaPacotes->buscar(idPacote);
-        if (eventosPacote == nullptr) continue;
+void Carregamento::escreverNotificacoes(std::ostream& saida) {
+    // Com a lista vazia, a coleta troca os buffers com o motor em vez de copiar.
+    motor->coletarNotificacoes(notificacoes);
+    for (const Notificacao& notificacao : notificacoes) {
+        FormatadorSaida::escreverNotificacao(notificacao, saida);
+    }
+    notificacoes.limpar();
+}
 
-        Evento* ultimoEvento = nullptr;
-        Evento* eventoRegistro = nullptr;
+void Carregamento::executarPipeline() {
+    std::ifstream inputFile(this->filename);
+    if (!inputFile.is_open()) {
+        std::cerr << "Erro ao abrir o arquivo: " << this->filename << std::endl;
+        return;
+    }
 
-        for (int j = 0; j < eventosPacote->getTamanho(); ++j) {
-            Evento* ev = eventosPacote->obter(j);
-            if (ev->getTempo() <= tempo) {
-                // Encontra o evento de registro (RG)
-                if (ev->tipo == RG) {
-                    eventoRegistro = ev;
+    // Os estágios trocam lotes alocados dinamicamente; quem remove um lote da
+    // fila passa a ser seu dono. Um ponteiro nulo sinaliza o fim do fluxo.
+    const int tamanhoLote = 1024;
+    const size_t capacidadeFila = 64;
+    FilaSPSC<Lista<std::string>*> filaLinhas(capacidadeFila);
+    FilaSPSC<Lista<Comando>*> filaComandos(capacidadeFila);
+    FilaSPSC<std::string*> filaSaida(capacidadeFila);
+
+    // Estágio 1: leitura das linhas do arquivo.
+    std::thread leitor([&]() {
+        Rastreamento::nomearThread("leitor");
+        Lista<std::string>* lote = new Lista<std::string>();
+        std::string linha;
+        int64_t inicioLote = Rastreamento::ativo() ? Rastreamento::agora() : 0;
+        long linhasLidas = 0;
+        while (std::getline(inputFile, linha)) {
+            if (linha.empty()) continue;
+            lote->adicionar(linha);
+            if (lote->getTamanho() == tamanhoLote) {
+                if (Rastreamento::ativo()) {
+                    int64_t agora = Rastreamento::agora();
+                    Rastreamento::registrar("lerLote", inicioLote, agora, "primeiraLinha", linhasLidas + 1);
+                    inicioLote = agora;
                 }
-                // Encontra o último evento no tempo, com desempate pelo tipo de evento
-                if (ultimoEvento == nullptr || ev->getTempo() > ultimoEvento->getTempo() ||
-                   (ev->getTempo() == ultimoEvento->getTempo() && ev->tipo > ultimoEvento->tipo)) {
-                    ultimoEvento = ev;
+                linhasLidas += tamanhoLote;
+                filaLinhas.inserir(lote);
+                lote = new Lista<std::string>();
+            }
+        }
+        if (Rastreamento::ativo()) {
+            Rastreamento::registrar("lerLote", inicioLote, Rastreamento::agora(), "primeiraLinha", linhasLidas + 1);
+        }
+        filaLinhas.inserir(lote);
+        filaLinhas.inserir(nullptr);
+    });
+
+    // Estágio 2: interpretação das linhas em comandos.
+    std::thread analisador([&]() {
+        Rastreamento::nomearThread("analisador");
+        while (Lista<std::string>* linhas = filaLinhas.remover()) {
+            EscopoRastreamento escopo("analisarLote", "linhas", linhas->getTamanho());
+            Lista<Comando>* comandos = new Lista<Comando>();
+            for (int i = 0; i < linhas->getTamanho(); ++i) {
+                Comando comando;
+                if (AnalisadorLinha::analisarLinha(linhas->obter(i), comando)) {
+                    comandos->adicionar(comando);
                 }
             }
+            delete linhas;
+            filaComandos.inserir(comandos);
         }
-
-        // Adiciona o evento de registro, se encontrado e ainda não estiver na lista
-        if (eventoRegistro != nullptr && !eventosResultantes.contem(eventoRegistro)) {
-            eventosResultantes.adicionar(eventoRegistro);
+        filaComandos.inserir(nullptr);
+    });
+
+    // Estágio 3: execução sobre o motor. É o único estágio que acessa os índices.
+    std::thread executor([&]() {
+        Rastreamento::nomearThread("executor");
+        long comandosExecutados = 0;
+        while (Lista<Comando>* comandos = filaComandos.remover()) {
+            EscopoRastreamento escopo("processarLinha", "comandos", comandos->getTamanho());
+            std::ostringstream saida;
+            for (int i = 0; i < comandos->getTamanho(); ++i) {
+                executarComando(comandos->obter(i), saida);
+                // As linhas estão espalhadas pelas filas; só as estruturas do executor são medidas.
+                acompanharMemoria(nullptr, comandosExecutados, comandosExecutados + 1);
+                comandosExecutados++;
+            }
+            delete comandos;
+            std::string* texto = new std::string(saida.str());
+            if (texto->empty()) {
+                delete texto;
+            } else {
+                filaSaida.inserir(texto);
+            }
         }
-        // Adiciona o último evento, se encontrado e ainda não estiver na lista
-        if (ultimoEvento != nullptr && !eventosResultantes.contem(ultimoEvento)) {
-            eventosResultantes.adicionar(ultimoEvento);
+        filaSaida.inserir(nullptr);
+    });
+
+    // Estágio 4: escrita da saída.
+    std::thread escritor([&]() {
+        Rastreamento::nomearThread("escritor");
+        while (std::string* texto = filaSaida.remover()) {
+            EscopoRastreamento escopo("escreverSaida", "bytes", static_cast<long>(texto->size()));
+            std::cout << *texto;
+            delete texto;
         }
+        EscopoRastreamento escopo("flush");
+        std::cout.flush();
+    });
+
+    leitor.join();
+    analisador.join();
+    executor.join();
+    escritor.join();
+    amostrarMemoria(nullptr, "final", true);
+}
+
+void Carregamento::executarParticionado(int numParticoes) {
+    Lista<std::string> linhas;
+    if (!carregarLinhas(linhas)) {
+        return;
     }
 
-    ordenarEventos(eventosResultantes);
+    ExecutorParticionado executor(numParticoes, opcoes);
+    executor.executar(linhas, std::cout);
+    amostrarMemoria(&linhas, "final", true, &executor);
+}
 
-    std::cout << eventosResultantes.getTamanho() << std::endl;
-    for (int i = 0; i < eventosResultantes.getTamanho(); ++i) {
-        eventosResultantes.obter(i)->imprimir();
+void Carregamento::executarComReordenacao(int atrasoMaximo) {
+    Lista<std::string> linhas;
+    if (!carregarLinhas(linhas)) {
+        return;
     }
-}
 
-TipoEvento Carregamento::stringParaTipoEvento(const std::string& s) {
-    if (s == "RG") return RG;
-    if (s == "AR") return AR;
-    if (s == "RM") return RM;
-    if (s == "UR") return UR;
-    if (s == "TR") return TR;
-    if (s == "EN") return EN;
-    return INDEFINIDO;
-}
+    BufferReordenacao buffer(atrasoMaximo);
+    for (int i = 0; i < linhas.getTamanho(); ++i) {
+        Comando comando;
+        if (AnalisadorLinha::analisarLinha(linhas.obter(i), comando)) {
+            buffer.inserir(comando);
+        }
+        Comando liberado;
+        while (buffer.extrair(liberado)) {
+            executarComando(liberado, std::cout);
+        }
+        acompanharMemoria(&linhas, i, i + 1);
+    }
 
-// Função de comparação estática para o método de ordenação.
-static bool compararEventos(Evento* a, Evento* b) {
-    if (a->getTempo() != b->getTempo()) {
-        return a->getTempo() < b->getTempo();
+    // Fim da entrada: nenhum evento ainda pode chegar, então tudo é liberado.
+    buffer.encerrar();
+    Comando liberado;
+    while (buffer.extrair(liberado)) {
+        executarComando(liberado, std::cout);
     }
-    return a->idPacote < b->idPacote;
-}
 
-void Carregamento::ordenarEventos(Lista<Evento*>& lista) {
-    lista.ordenar(compararEventos);
+    if (buffer.getDescartados() > 0) {
+        std::cerr << "Eventos descartados por atraso: " << buffer.getDescartados() << std::endl;
+    }
+    amostrarMemoria(&linhas, "final", true);
 }
 
 void Carregamento::executarComTiming() {
     // 1. Ler todas as linhas para a memória primeiro
-    std::ifstream inputFile(this->filename);
-    if (!inputFile.is_open()) {
-        std::cerr << "Erro ao abrir o arquivo: " << this->filename << std::endl;
-        return;
-    }
-
     Lista<std::string> linhas;
-    std::string linha;
-    while (std::getline(inputFile, linha)) {
-        if (!linha.empty()) {
-            linhas.adicionar(linha);
-        }
+    if (!carregarLinhas(linhas)) {
+        return;
     }
-    inputFile.close();
 
     // 2. Medir o tempo de processamento
     auto start = std::chrono::high_resolution_clock::now();
 
-    for (int i = 0; i < linhas.getTamanho(); ++i) {
-        processarLinha(linhas.obter(i));
-    }
+    processarLinhas(linhas, std::cout);
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> duration = end - start;
 
     // Imprime o tempo de processamento em stderr para não interferir com a saída padrão
     std::cerr << "Processing time: " << duration.count() << " ms" << std::endl;
+    if (motor->getPacotesArquivados() > 0) {
+        std::cerr << "Retention: " << motor->getPacotesArquivados() << " packages archived, "
+                  << motor->getEventosCompactados() << " events compacted, "
+                  << motor->getQuantidadeEventos() << " events resident" << std::endl;
+    }
+    if (motor->getQuantidadeSegmentos() > 0) {
+        std::cerr << "Segments: " << motor->getQuantidadeSegmentos() << " on disk, "
+                  << motor->getEventosEmDisco() << " events spilled, "
+                  << motor->getQuantidadeEventos() << " events resident" << std::endl;
+    }
+    if (cacheClientes != nullptr) {
+        std::cerr << "CL cache: " << cacheClientes->getAcertos() << " hits, "
+                  << cacheClientes->getFalhas() << " misses, "
+                  << cacheClientes->getBytesUsados() << " bytes" << std::endl;
+    }
+    amostrarMemoria(&linhas, "final", true);
+}
+
+void Carregamento::executarBenchmarkAnalisador() {
+    Lista<std::string> linhas;
+    if (!carregarLinhas(linhas)) {
+        return;
+    }
+
+    long bytes = 0;
+    for (int i = 0; i < linhas.getTamanho(); ++i) {
+        bytes += static_cast<long>(linhas.obter(i).size()) + 1; // inclui a quebra de linha
+    }
+
+    const int repeticoes = 5;
+    long eventosRapidos = 0;
+    long eventosGerais = 0;
+    long checagem = 0; // Evita que o compilador descarte o trabalho medido.
+    Evento ev;
+
+    // Caminho geral: stringstream e comparações de string para todas as linhas.
+    auto inicioGeral = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeticoes; ++r) {
+        for (int i = 0; i < linhas.getTamanho(); ++i) {
+            if (AnalisadorLinha::analisarEventoGeral(linhas.obter(i), ev)) {
+                checagem += ev.idPacote;
+            }
+        }
+    }
+    auto fimGeral = std::chrono::high_resolution_clock::now();
+
+    // Caminho rápido (SWAR), com recurso ao geral para linhas fora do layout fixo.
+    auto inicioRapido = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeticoes; ++r) {
+        for (int i = 0; i < linhas.getTamanho(); ++i) {
+            const std::string& linha = linhas.obter(i);
+            if (AnalisadorLinha::analisarEventoRapido(linha, ev)) {
+                eventosRapidos++;
+                checagem += ev.idPacote;
+            } else if (AnalisadorLinha::analisarEventoGeral(linha, ev)) {
+                eventosGerais++;
+                checagem += ev.idPacote;
+            }
+        }
+    }
+    auto fimRapido = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double> duracaoGeral = fimGeral - inicioGeral;
+    std::chrono::duration<double> duracaoRapido = fimRapido - inicioRapido;
+    double gigabytes = static_cast<double>(bytes) * repeticoes / 1e9;
+
+    std::cerr << "Parser benchmark: " << linhas.getTamanho() << " lines, " << bytes << " bytes, "
+              << repeticoes << " repetitions (checksum " << checagem << ")" << std::endl;
+    std::cerr << "  general path: " << gigabytes / duracaoGeral.count() << " GB/s" << std::endl;
+    std::cerr << "  fast path:    " << gigabytes / duracaoRapido.count() << " GB/s ("
+              << eventosRapidos / repeticoes << " events fixed-width, "
+              << eventosGerais / repeticoes << " via fallback)" << std::endl;
 }
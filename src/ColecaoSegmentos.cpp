@@ -0,0 +1,177 @@
+#include "../include/ColecaoSegmentos.hpp"
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+/**
+ * @file ColecaoSegmentos.cpp
+ * @brief Implementação da classe ColecaoSegmentos.
+ */
+
+ColecaoSegmentos::ColecaoSegmentos(const std::string& diretorioBase)
+    : proximoArquivo(0), mescla(nullptr), mesclaConcluida(false), inicioMescla(0), resultadoMescla(nullptr) {
+    std::string base = diretorioBase;
+    if (base.empty()) {
+        const char* temporario = std::getenv("TMPDIR");
+        base = (temporario != nullptr && temporario[0] != '\0') ? temporario : "/tmp";
+    }
+
+    std::string modelo = base + "/tp3-segmentos-XXXXXX";
+    Lista<char> caminho;
+    for (size_t i = 0; i < modelo.size(); ++i) {
+        caminho.adicionar(modelo[i]);
+    }
+    caminho.adicionar('\0');
+    if (mkdtemp(caminho.dados()) == nullptr) {
+        throw std::runtime_error("Não foi possível criar o diretório de segmentos em " + base);
+    }
+    diretorio = caminho.dados();
+}
+
+ColecaoSegmentos::~ColecaoSegmentos() {
+    // Descarta a mescla em andamento; seus segmentos de origem ainda estão na lista.
+    if (mescla != nullptr) {
+        mescla->join();
+        delete mescla;
+        delete resultadoMescla;
+    }
+    for (int i = 0; i < segmentos.getTamanho(); ++i) {
+        delete segmentos.obter(i);
+    }
+    rmdir(diretorio.c_str());
+}
+
+std::string ColecaoSegmentos::novoCaminho() {
+    std::ostringstream caminho;
+    caminho << diretorio << "/segmento-" << proximoArquivo++ << ".seg";
+    return caminho.str();
+}
+
+void ColecaoSegmentos::despejar(const Lista<int>& ids, const Lista<VisaoHistorico>& historicos) {
+    incorporarMescla(false);
+
+    std::string caminho = novoCaminho();
+    SegmentoDisco* segmento = nullptr;
+    if (SegmentoDisco::gravar(caminho, ids, historicos)) {
+        segmento = SegmentoDisco::abrir(caminho);
+    }
+    if (segmento == nullptr) {
+        unlink(caminho.c_str());
+        throw std::runtime_error("Falha ao gravar o segmento " + caminho);
+    }
+    segmento->descartarAoFechar();
+    segmentos.adicionar(segmento);
+
+    considerarMescla();
+    // Se as mesclas não acompanham os despejos, espera por elas, para que o
+    // número de segmentos consultados por PC e CL continue limitado.
+    while (mescla != nullptr && segmentos.getTamanho() > LIMITE_SEGMENTOS) {
+        incorporarMescla(true);
+    }
+}
+
+void ColecaoSegmentos::considerarMescla() {
+    if (mescla != nullptr) {
+        return;
+    }
+
+    // Procura, dos segmentos mais recentes para os mais antigos, `FATOR_MESCLA`
+    // segmentos consecutivos da mesma camada (tamanhos a menos de um fator 2),
+    // para que cada evento seja regravado O(log n) vezes.
+    int inicio = -1;
+    for (int i = segmentos.getTamanho() - FATOR_MESCLA; i >= 0 && inicio < 0; --i) {
+        int menor = segmentos.obter(i)->getQuantidade();
+        int maior = menor;
+        for (int j = i + 1; j < i + FATOR_MESCLA; ++j) {
+            int quantidade = segmentos.obter(j)->getQuantidade();
+            if (quantidade < menor) menor = quantidade;
+            if (quantidade > maior) maior = quantidade;
+        }
+        if (maior <= 2 * menor) {
+            inicio = i;
+        }
+    }
+    if (inicio < 0) {
+        return;
+    }
+
+    inicioMescla = inicio;
+    for (int i = 0; i < FATOR_MESCLA; ++i) {
+        origensMescla[i] = segmentos.obter(inicioMescla + i);
+    }
+    std::string caminho = novoCaminho();
+    mesclaConcluida.store(false, std::memory_order_relaxed);
+    mescla = new std::thread([this, caminho]() {
+        SegmentoDisco* resultado = nullptr;
+        if (SegmentoDisco::mesclar(caminho, origensMescla, FATOR_MESCLA)) {
+            resultado = SegmentoDisco::abrir(caminho);
+        }
+        if (resultado == nullptr) {
+            unlink(caminho.c_str());
+        } else {
+            resultado->descartarAoFechar();
+        }
+        resultadoMescla = resultado;
+        mesclaConcluida.store(true, std::memory_order_release);
+    });
+}
+
+void ColecaoSegmentos::incorporarMescla(bool aguardar) {
+    if (mescla == nullptr || (!aguardar && !mesclaConcluida.load(std::memory_order_acquire))) {
+        return;
+    }
+    mescla->join();
+    delete mescla;
+    mescla = nullptr;
+
+    if (resultadoMescla == nullptr) {
+        return; // A mescla falhou; os segmentos de origem continuam válidos.
+    }
+
+    Lista<SegmentoDisco*> atualizados;
+    for (int i = 0; i < inicioMescla; ++i) {
+        atualizados.adicionar(segmentos.obter(i));
+    }
+    atualizados.adicionar(resultadoMescla);
+    for (int i = inicioMescla + FATOR_MESCLA; i < segmentos.getTamanho(); ++i) {
+        atualizados.adicionar(segmentos.obter(i));
+    }
+    for (int i = 0; i < FATOR_MESCLA; ++i) {
+        delete origensMescla[i];
+    }
+    segmentos.trocar(atualizados);
+    resultadoMescla = nullptr;
+
+    considerarMescla();
+}
+
+int ColecaoSegmentos::coletarPacote(int idPacote, int tempo, Lista<Evento>& saida) const {
+    int partes = 0;
+    for (int s = 0; s < segmentos.getTamanho(); ++s) {
+        if (segmentos.obter(s)->buscarPacote(idPacote).decodificarAte(tempo, idPacote, saida) > 0) {
+            partes++;
+        }
+    }
+    return partes;
+}
+
+void ColecaoSegmentos::selecionarParaCliente(int idPacote, int tempo, SelecaoCliente& selecao) const {
+    for (int s = 0; s < segmentos.getTamanho(); ++s) {
+        segmentos.obter(s)->buscarPacote(idPacote).selecionarParaCliente(tempo, idPacote, s, selecao);
+    }
+}
+
+void ColecaoSegmentos::contarEventos(int tempo, long* contagens) const {
+    for (int s = 0; s < segmentos.getTamanho(); ++s) {
+        segmentos.obter(s)->contarEventos(tempo, contagens);
+    }
+}
+
+long ColecaoSegmentos::getQuantidadeEventos() const {
+    long total = 0;
+    for (int s = 0; s < segmentos.getTamanho(); ++s) {
+        total += segmentos.obter(s)->getQuantidade();
+    }
+    return total;
+}
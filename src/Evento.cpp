@@ -37,40 +37,40 @@ Evento::Evento() {
 }
 
 /**
- * @brief Imprime os detalhes do evento para o console.
+ * @brief Imprime os detalhes do evento no fluxo de saída informado.
  * 
  * Formata a saída de acordo com o tipo de evento, exibindo informações relevantes
  * como timestamp, tipo de evento, ID do pacote e outros dados específicos do evento.
  * Utiliza `std::setw` e `std::setfill` para garantir a formatação correta dos números.
  */
-void Evento::imprimir() {
-    std::cout << std::setw(7) << std::setfill('0') << dataHora << " EV " << tipoEventoParaString(tipo) << " "
-              << std::setw(3) << std::setfill('0') << idPacote;
+void Evento::imprimir(std::ostream& saida) const {
+    saida << std::setw(7) << std::setfill('0') << dataHora << " EV " << tipoEventoParaString(tipo) << " "
+          << std::setw(3) << std::setfill('0') << idPacote;
 
     switch (tipo) {
         case RG:
-            std::cout << " " << remetente << " " << destinatario << " "
-                      << std::setw(3) << std::setfill('0') << armazemOrigem << " "
-                      << std::setw(3) << std::setfill('0') << armazemDestino;
+            saida << " " << remetente << " " << destinatario << " "
+                  << std::setw(3) << std::setfill('0') << armazemOrigem << " "
+                  << std::setw(3) << std::setfill('0') << armazemDestino;
             break;
         case AR:
         case RM:
         case UR:
-            std::cout << " " << std::setw(3) << std::setfill('0') << armazemOrigem << " "
-                      << std::setw(3) << std::setfill('0') << secaoDestino;
+            saida << " " << std::setw(3) << std::setfill('0') << armazemOrigem << " "
+                  << std::setw(3) << std::setfill('0') << secaoDestino;
             break;
         case TR:
-            std::cout << " " << std::setw(3) << std::setfill('0') << armazemOrigem << " "
-                      << std::setw(3) << std::setfill('0') << armazemDestino;
+            saida << " " << std::setw(3) << std::setfill('0') << armazemOrigem << " "
+                  << std::setw(3) << std::setfill('0') << armazemDestino;
             break;
         case EN:
-            std::cout << " " << std::setw(3) << std::setfill('0') << armazemDestino;
+            saida << " " << std::setw(3) << std::setfill('0') << armazemDestino;
             break;
         case INDEFINIDO:
             // Não imprime informações adicionais para tipos indefinidos.
             break;
     }
-    std::cout << std::endl;
+    saida << std::endl;
 }
 
 /**
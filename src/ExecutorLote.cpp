@@ -0,0 +1,217 @@
+#include "../include/ExecutorLote.hpp"
+#include "../include/Carregamento.hpp"
+#include "../include/Mapa.hpp"
+#include "../include/Rastreamento.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <thread>
+
+/**
+ * @file ExecutorLote.cpp
+ * @brief Implementação da classe ExecutorLote.
+ */
+
+namespace {
+    const int TAMANHO_BUFFER_SAIDA = 1 << 20; ///< Buffer de escrita de cada arquivo de saída.
+
+    /**
+     * @brief Retorna o tamanho de um arquivo, ou 0 se ele não existir.
+     */
+    long tamanhoArquivo(const std::string& caminho) {
+        struct stat info;
+        if (stat(caminho.c_str(), &info) != 0) {
+            return 0;
+        }
+        return static_cast<long>(info.st_size);
+    }
+}
+
+ExecutorLote::ExecutorLote(const Lista<std::string>& arquivos, const OpcoesLote& opcoesLote,
+                           const OpcoesMotor& opcoesMotor)
+    : arquivos(arquivos), opcoesLote(opcoesLote), opcoesMotor(opcoesMotor), proximoArquivo(0),
+      memoriaReservada(0), emAndamento(0) {
+    // Duas entradas com o mesmo nome em diretórios diferentes disputariam a mesma saída.
+    Mapa<std::string, bool> saidas;
+    resultados.resize(arquivos.getTamanho());
+    for (int i = 0; i < arquivos.getTamanho(); ++i) {
+        resultados[i].saida = caminhoSaida(arquivos[i]);
+        if (saidas.buscar(resultados[i].saida)) {
+            resultados[i].erro = "duplicate output";
+        } else {
+            saidas.inserir(resultados[i].saida, true);
+        }
+    }
+}
+
+bool ExecutorLote::lerManifesto(const std::string& caminho, Lista<std::string>& arquivos) {
+    std::ifstream manifesto(caminho);
+    if (!manifesto.is_open()) {
+        return false;
+    }
+    std::string linha;
+    while (std::getline(manifesto, linha)) {
+        size_t fim = linha.find_last_not_of(" \t\r");
+        if (fim == std::string::npos || linha[0] == '#') {
+            continue;
+        }
+        arquivos.adicionar(linha.substr(0, fim + 1));
+    }
+    return true;
+}
+
+std::string ExecutorLote::caminhoSaida(const std::string& entrada) const {
+    if (opcoesLote.diretorioSaida.empty()) {
+        return entrada + ".out";
+    }
+    size_t barra = entrada.find_last_of('/');
+    std::string nome = barra == std::string::npos ? entrada : entrada.substr(barra + 1);
+    return opcoesLote.diretorioSaida + "/" + nome + ".out";
+}
+
+int ExecutorLote::reservarProximo(long& reserva) {
+    std::unique_lock<std::mutex> bloqueio(trava);
+    if (proximoArquivo >= arquivos.getTamanho()) {
+        return -1;
+    }
+    int indice = proximoArquivo++;
+    reserva = tamanhoArquivo(arquivos[indice]) * FATOR_MEMORIA;
+    if (opcoesLote.memoriaMaxima > 0) {
+        memoriaLiberada.wait(bloqueio, [&]() {
+            return emAndamento == 0 || memoriaReservada + reserva <= opcoesLote.memoriaMaxima;
+        });
+    }
+    memoriaReservada += reserva;
+    emAndamento++;
+    return indice;
+}
+
+void ExecutorLote::liberarReserva(long reserva) {
+    {
+        std::lock_guard<std::mutex> bloqueio(trava);
+        memoriaReservada -= reserva;
+        emAndamento--;
+    }
+    memoriaLiberada.notify_all();
+}
+
+void ExecutorLote::trabalhar(int indiceThread) {
+    Rastreamento::nomearThread("lote " + std::to_string(indiceThread));
+    long reserva = 0;
+    for (int indice = reservarProximo(reserva); indice >= 0; indice = reservarProximo(reserva)) {
+        processarArquivo(indice, indiceThread);
+        liberarReserva(reserva);
+    }
+}
+
+void ExecutorLote::processarArquivo(int indice, int indiceThread) {
+    Resultado& resultado = resultados[indice];
+    resultado.thread = indiceThread;
+    if (!resultado.erro.empty()) {
+        return;
+    }
+    EscopoRastreamento escopo("arquivo", "indice", indice);
+    auto inicio = std::chrono::steady_clock::now();
+
+    Lista<char> buffer;
+    buffer.resize(TAMANHO_BUFFER_SAIDA);
+    std::ofstream saida;
+    saida.rdbuf()->pubsetbuf(buffer.dados(), buffer.getTamanho());
+    saida.open(resultado.saida);
+    if (!saida.is_open()) {
+        resultado.erro = "cannot create output";
+        return;
+    }
+
+    try {
+        Carregamento carregamento(arquivos[indice], opcoesMotor);
+        if (opcoesLote.limiteCacheClientes >= 0) {
+            carregamento.configurarCacheClientes(static_cast<size_t>(opcoesLote.limiteCacheClientes));
+        }
+        if (!carregamento.executar(saida)) {
+            resultado.erro = "cannot open input";
+        }
+        resultado.linhas = carregamento.getLinhasLidas();
+        resultado.bytes = carregamento.getBytesLidos();
+    } catch (const std::runtime_error& erro) {
+        // E.g., o diretório dos segmentos em disco não pôde ser criado.
+        resultado.erro = erro.what();
+    }
+    saida.close();
+    if (resultado.erro.empty() && saida.fail()) {
+        resultado.erro = "write error";
+    }
+    if (!resultado.erro.empty()) {
+        // Uma saída incompleta não deve ser confundida com o resultado do arquivo.
+        std::remove(resultado.saida.c_str());
+    }
+
+    std::chrono::duration<double, std::milli> duracao = std::chrono::steady_clock::now() - inicio;
+    resultado.ms = duracao.count();
+}
+
+int ExecutorLote::executar(std::ostream& resumo) {
+    int numThreads = opcoesLote.threads;
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+        if (numThreads <= 0) numThreads = 1;
+    }
+    if (numThreads > arquivos.getTamanho()) {
+        numThreads = arquivos.getTamanho() > 0 ? arquivos.getTamanho() : 1;
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    Lista<std::thread*> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.adicionar(new std::thread(&ExecutorLote::trabalhar, this, i));
+    }
+    for (std::thread* thread : threads) {
+        thread->join();
+        delete thread;
+    }
+    std::chrono::duration<double, std::milli> duracao = std::chrono::steady_clock::now() - inicio;
+
+    escreverResumo(resumo, numThreads, duracao.count());
+
+    int falhas = 0;
+    for (const Resultado& resultado : resultados) {
+        if (!resultado.erro.empty()) {
+            falhas++;
+        }
+    }
+    return falhas;
+}
+
+void ExecutorLote::escreverResumo(std::ostream& resumo, int numThreads, double msTotal) const {
+    // Uma linha por arquivo e, por fim, a linha "total" do lote, cuja coluna `thread` é o número de threads.
+    long linhasTotal = 0;
+    long bytesTotal = 0;
+    int falhas = 0;
+    resumo << "file,output,thread,lines,bytes,ms,lines_per_s,mb_per_s,status" << std::endl;
+    for (int i = 0; i < resultados.getTamanho(); ++i) {
+        const Resultado& resultado = resultados[i];
+        escreverLinhaResumo(resumo, arquivos[i], resultado.saida, resultado.thread, resultado.linhas,
+                            resultado.bytes, resultado.ms, resultado.erro.empty() ? "ok" : resultado.erro);
+        linhasTotal += resultado.linhas;
+        bytesTotal += resultado.bytes;
+        if (!resultado.erro.empty()) {
+            falhas++;
+        }
+    }
+    escreverLinhaResumo(resumo, "total", "", numThreads, linhasTotal, bytesTotal, msTotal,
+                        falhas == 0 ? "ok" : std::to_string(falhas) + " failed");
+}
+
+void ExecutorLote::escreverLinhaResumo(std::ostream& resumo, const std::string& arquivo, const std::string& saida,
+                                       int thread, long linhas, long bytes, double ms, const std::string& estado) {
+    double segundos = ms / 1000.0;
+    resumo << arquivo << "," << saida << "," << thread << "," << linhas << "," << bytes << ","
+           << std::fixed << std::setprecision(1) << ms << ","
+           << (segundos > 0 ? linhas / segundos : 0.0) << ","
+           << std::setprecision(2) << (segundos > 0 ? bytes / segundos / 1e6 : 0.0) << ","
+           << estado << std::endl;
+    resumo.unsetf(std::ios::floatfield);
+}
@@ -0,0 +1,291 @@
+#include "../include/ExecutorParticionado.hpp"
+#include "../include/FormatadorSaida.hpp"
+#include "../include/Rastreamento.hpp"
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/**
+ * @file ExecutorParticionado.cpp
+ * @brief Implementação da classe ExecutorParticionado.
+ */
+
+namespace {
+    const int TAMANHO_LOTE = 256;         ///< Tarefas por lote enviado a uma partição.
+    const size_t CAPACIDADE_FILA = 64;    ///< Lotes em trânsito por partição.
+    const size_t CAPACIDADE_CONSULTAS = 4096; ///< Consultas aguardando a escritora.
+}
+
+ExecutorParticionado::ExecutorParticionado(int numParticoes, const OpcoesMotor& opcoes)
+    : numParticoes(numParticoes),
+      rankings(opcoes.capacidadeRanking, opcoes.rankingAproximado),
+      filaConsultas(CAPACIDADE_CONSULTAS) {
+    OpcoesMotor opcoesParticao = opcoes;
+    opcoesParticao.manterRankings = false;
+    if (opcoes.memoriaMaxima > 0) {
+        // O orçamento de memória vale para o processo, não para cada partição.
+        opcoesParticao.memoriaMaxima = opcoes.memoriaMaxima / numParticoes > 0 ? opcoes.memoriaMaxima / numParticoes : 1;
+    }
+
+    particoes = new Particao[numParticoes];
+    for (int i = 0; i < numParticoes; ++i) {
+        particoes[i].motor = new MotorLogistico(opcoesParticao);
+        particoes[i].fila = new FilaSPSC<Lista<Tarefa>*>(CAPACIDADE_FILA);
+        particoes[i].lote = new Lista<Tarefa>();
+    }
+}
+
+ExecutorParticionado::~ExecutorParticionado() {
+    for (int i = 0; i < numParticoes; ++i) {
+        delete particoes[i].motor;
+        delete particoes[i].fila;
+        delete particoes[i].lote;
+    }
+    delete[] particoes;
+}
+
+void ExecutorParticionado::medirMemoria(RelatorioMemoria& relatorio) const {
+    for (int i = 0; i < numParticoes; ++i) {
+        particoes[i].motor->medirMemoria(relatorio);
+    }
+    relatorio.registrar("rankings", rankings.getUsoMemoria(), 3);
+}
+
+void ExecutorParticionado::enviarTarefa(int indice, const Tarefa& tarefa) {
+    Particao& particao = particoes[indice];
+    particao.lote->adicionar(tarefa);
+    if (particao.lote->getTamanho() == TAMANHO_LOTE) {
+        particao.fila->inserir(particao.lote);
+        particao.lote = new Lista<Tarefa>();
+    }
+}
+
+void ExecutorParticionado::esvaziarLotes() {
+    for (int i = 0; i < numParticoes; ++i) {
+        if (particoes[i].lote->getTamanho() > 0) {
+            particoes[i].fila->inserir(particoes[i].lote);
+            particoes[i].lote = new Lista<Tarefa>();
+        }
+    }
+}
+
+void ExecutorParticionado::executar(const Lista<std::string>& linhas, std::ostream& saida) {
+    Lista<std::thread*> threads;
+    for (int i = 0; i < numParticoes; ++i) {
+        threads.adicionar(new std::thread(&ExecutorParticionado::executarParticao, this, i));
+    }
+    std::thread escritora(&ExecutorParticionado::escreverRespostas, this, std::ref(saida));
+
+    Tarefa tarefa;
+    long assinaturasIgnoradas = 0;
+    for (int i = 0; i < linhas.getTamanho(); ++i) {
+        Comando comando;
+        if (!AnalisadorLinha::analisarLinha(linhas.obter(i), comando)) {
+            continue;
+        }
+
+        if (comando.tipo == COMANDO_EVENTO) {
+            rankings.registrarEvento(comando.evento);
+            tarefa.evento = comando.evento;
+            tarefa.consulta = nullptr;
+            enviarTarefa(particaoDoPacote(comando.evento.idPacote), tarefa);
+            continue;
+        }
+
+        // As notificações seguem a ordem global de ingestão, que as partições não compartilham.
+        if (comando.tipo == COMANDO_ASSINATURA || comando.tipo == COMANDO_CANCELAMENTO) {
+            assinaturasIgnoradas++;
+            continue;
+        }
+
+        ConsultaDistribuida* consulta = new ConsultaDistribuida();
+        consulta->comando = comando;
+        switch (comando.tipo) {
+            case COMANDO_PACOTE:
+            case COMANDO_ROTA:
+                consulta->particaoUnica = particaoDoPacote(comando.idPacote);
+                consulta->parciais = new ResultadoParcial[1];
+                consulta->pendentes.store(1, std::memory_order_relaxed);
+                break;
+            case COMANDO_CLIENTE:
+            case COMANDO_TRECHO:
+            case COMANDO_CONTAGEM:
+                consulta->parciais = new ResultadoParcial[numParticoes];
+                consulta->pendentes.store(numParticoes, std::memory_order_relaxed);
+                break;
+            default: {
+                // RK depende apenas dos rankings globais: responde imediatamente.
+                std::ostringstream texto;
+                FormatadorSaida::escreverRanking(comando.dataHora, comando.texto, comando.parametro1, &rankings, texto);
+                consulta->texto = texto.str();
+                break;
+            }
+        }
+
+        tarefa.evento = Evento();
+        tarefa.consulta = consulta;
+        if (consulta->particaoUnica >= 0) {
+            enviarTarefa(consulta->particaoUnica, tarefa);
+        } else if (consulta->parciais != nullptr) {
+            for (int p = 0; p < numParticoes; ++p) {
+                enviarTarefa(p, tarefa);
+            }
+        }
+
+        // Se a escritora estiver atrasada, ela pode estar esperando uma consulta
+        // ainda parada em um lote incompleto: envia os lotes antes de bloquear.
+        if (!filaConsultas.tentarInserir(consulta)) {
+            esvaziarLotes();
+            filaConsultas.inserir(consulta);
+        }
+    }
+
+    esvaziarLotes();
+    for (int i = 0; i < numParticoes; ++i) {
+        particoes[i].fila->inserir(nullptr);
+    }
+    filaConsultas.inserir(nullptr);
+
+    for (int i = 0; i < threads.getTamanho(); ++i) {
+        threads.obter(i)->join();
+        delete threads.obter(i);
+    }
+    escritora.join();
+
+    if (assinaturasIgnoradas > 0) {
+        std::cerr << "Assinaturas ignoradas no modo particionado: " << assinaturasIgnoradas << std::endl;
+    }
+}
+
+void ExecutorParticionado::executarParticao(int indice) {
+    Particao& particao = particoes[indice];
+    Rastreamento::nomearThread("particao " + std::to_string(indice));
+    while (Lista<Tarefa>* lote = particao.fila->remover()) {
+        EscopoRastreamento escopo("executarLote", "particao", indice);
+        for (int i = 0; i < lote->getTamanho(); ++i) {
+            const Tarefa& tarefa = (*lote)[i];
+            if (tarefa.consulta == nullptr) {
+                particao.motor->ingerir(tarefa.evento);
+            } else {
+                responderConsulta(indice, tarefa.consulta);
+            }
+        }
+        delete lote;
+    }
+}
+
+void ExecutorParticionado::responderConsulta(int indice, ConsultaDistribuida* consulta) {
+    const MotorLogistico* motor = particoes[indice].motor;
+    const Comando& comando = consulta->comando;
+    ResultadoParcial& parcial = consulta->parciais[consulta->particaoUnica >= 0 ? 0 : indice];
+
+    switch (comando.tipo) {
+        case COMANDO_PACOTE:
+            parcial.eventos = motor->consultarPacote(comando.dataHora, comando.idPacote);
+            break;
+        case COMANDO_CLIENTE:
+            parcial.eventos = motor->consultarCliente(comando.dataHora, comando.texto);
+            break;
+        case COMANDO_ROTA:
+            parcial.paradas = motor->consultarRota(comando.dataHora, comando.idPacote);
+            break;
+        case COMANDO_TRECHO:
+            parcial.trechoEncontrado = motor->obterEstatisticasTrecho(comando.parametro1, comando.parametro2, parcial.trecho);
+            break;
+        case COMANDO_CONTAGEM:
+            motor->contarEventos(comando.dataHora, parcial.contagens);
+            break;
+        default:
+            break;
+    }
+
+    // Publica o resultado parcial; a última partição acorda a escritora. O
+    // mutex impede que o aviso se perca entre o teste e a espera da escritora.
+    if (consulta->pendentes.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> trava(mutexRespostas);
+        respostaPronta.notify_one();
+    }
+}
+
+void ExecutorParticionado::escreverRespostas(std::ostream& saida) {
+    Rastreamento::nomearThread("escritora");
+    while (ConsultaDistribuida* consulta = filaConsultas.remover()) {
+        if (consulta->pendentes.load(std::memory_order_acquire) > 0) {
+            std::unique_lock<std::mutex> trava(mutexRespostas);
+            respostaPronta.wait(trava, [consulta]() {
+                return consulta->pendentes.load(std::memory_order_acquire) == 0;
+            });
+        }
+        escreverResposta(consulta, saida);
+        delete consulta;
+    }
+    saida.flush();
+}
+
+void ExecutorParticionado::escreverResposta(const ConsultaDistribuida* consulta, std::ostream& saida) {
+    const Comando& comando = consulta->comando;
+    const ResultadoParcial* parciais = consulta->parciais;
+
+    switch (comando.tipo) {
+        case COMANDO_PACOTE:
+            FormatadorSaida::escreverPacote(comando.dataHora, comando.idPacote, parciais[0].eventos, saida);
+            break;
+        case COMANDO_ROTA:
+            FormatadorSaida::escreverRota(comando.dataHora, comando.idPacote, parciais[0].paradas, saida);
+            break;
+        case COMANDO_CLIENTE: {
+            // Intercala as listas parciais, já ordenadas por tempo e ID do pacote.
+            // Empates só ocorrem dentro de um mesmo pacote, logo de uma mesma partição.
+            Lista<Evento> eventos;
+            int* proximos = new int[numParticoes]();
+            while (true) {
+                int escolhida = -1;
+                for (int p = 0; p < numParticoes; ++p) {
+                    if (proximos[p] >= parciais[p].eventos.getTamanho()) continue;
+                    if (escolhida < 0) {
+                        escolhida = p;
+                        continue;
+                    }
+                    const Evento& candidato = parciais[p].eventos.obter(proximos[p]);
+                    const Evento& atual = parciais[escolhida].eventos.obter(proximos[escolhida]);
+                    if (candidato.dataHora < atual.dataHora ||
+                        (candidato.dataHora == atual.dataHora && candidato.idPacote < atual.idPacote)) {
+                        escolhida = p;
+                    }
+                }
+                if (escolhida < 0) break;
+                eventos.adicionar(parciais[escolhida].eventos.obter(proximos[escolhida]++));
+            }
+            delete[] proximos;
+            FormatadorSaida::escreverCliente(comando.dataHora, comando.texto, eventos, saida);
+            break;
+        }
+        case COMANDO_TRECHO: {
+            EstatisticasTrecho trecho;
+            bool encontrado = false;
+            for (int p = 0; p < numParticoes; ++p) {
+                if (parciais[p].trechoEncontrado) {
+                    trecho.mesclar(parciais[p].trecho);
+                    encontrado = true;
+                }
+            }
+            ResumoTrecho resumo = trecho.resumo();
+            FormatadorSaida::escreverTrecho(comando.dataHora, comando.parametro1, comando.parametro2,
+                                            encontrado ? &resumo : nullptr, saida);
+            break;
+        }
+        case COMANDO_CONTAGEM: {
+            long contagens[INDEFINIDO + 1] = {0};
+            for (int p = 0; p < numParticoes; ++p) {
+                for (int t = RG; t <= INDEFINIDO; ++t) {
+                    contagens[t] += parciais[p].contagens[t];
+                }
+            }
+            FormatadorSaida::escreverContagem(comando.dataHora, contagens, saida);
+            break;
+        }
+        default:
+            saida << consulta->texto;
+            break;
+    }
+}
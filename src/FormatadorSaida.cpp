@@ -0,0 +1,115 @@
+#include "../include/FormatadorSaida.hpp"
+#include <iomanip> // Para std::setw e std::setfill
+
+/**
+ * @file FormatadorSaida.cpp
+ * @brief Implementação da classe FormatadorSaida.
+ */
+
+void FormatadorSaida::escreverEventos(const Lista<Evento>& eventos, std::ostream& saida) {
+    saida << eventos.getTamanho() << std::endl;
+    for (const Evento& ev : eventos) {
+        ev.imprimir(saida);
+    }
+}
+
+void FormatadorSaida::escreverPacote(int tempo, int idPacote, const Lista<Evento>& eventos, std::ostream& saida) {
+    saida << std::setw(6) << std::setfill('0') << tempo << " PC " << std::setw(3) << std::setfill('0') << idPacote << std::endl;
+    escreverEventos(eventos, saida);
+}
+
+void FormatadorSaida::escreverCabecalhoCliente(int tempo, const std::string& nomeCliente, std::ostream& saida) {
+    saida << std::setw(6) << std::setfill('0') << tempo << " CL " << nomeCliente << std::endl;
+}
+
+void FormatadorSaida::escreverCliente(int tempo, const std::string& nomeCliente, const Lista<Evento>& eventos, std::ostream& saida) {
+    escreverCabecalhoCliente(tempo, nomeCliente, saida);
+    escreverEventos(eventos, saida);
+}
+
+void FormatadorSaida::escreverCabecalhoAssinatura(int tempo, const char* operacao, TipoAssinatura tipo,
+                                                   const std::string& nomeCliente, int idPacote, std::ostream& saida) {
+    saida << std::setw(6) << std::setfill('0') << tempo << " " << operacao;
+    if (tipo == ASSINATURA_CLIENTE) {
+        saida << " CL " << nomeCliente << std::endl;
+    } else {
+        saida << " PC " << std::setw(3) << std::setfill('0') << idPacote << std::endl;
+    }
+}
+
+void FormatadorSaida::escreverNotificacao(const Notificacao& notificacao, std::ostream& saida) {
+    escreverCabecalhoAssinatura(notificacao.tempo, "NT", notificacao.tipo, notificacao.nomeCliente,
+                                notificacao.idPacote, saida);
+    escreverEventos(notificacao.eventos, saida);
+}
+
+void FormatadorSaida::escreverRanking(int tempo, const std::string& categoria, int quantidade,
+                                      const RankingsAtividade* rankings, std::ostream& saida) {
+    saida << std::setw(6) << std::setfill('0') << tempo << " RK " << categoria << " " << quantidade << std::endl;
+
+    if (categoria == "AM") {
+        Lista<ItemRanking<int>> maiores;
+        if (rankings != nullptr) {
+            maiores = rankings->maioresArmazens(quantidade);
+        }
+        saida << maiores.getTamanho() << std::endl;
+        for (int i = 0; i < maiores.getTamanho(); ++i) {
+            saida << std::setw(3) << std::setfill('0') << maiores.obter(i).chave << " "
+                  << maiores.obter(i).contagem << std::endl;
+        }
+        return;
+    }
+
+    Lista<ItemRanking<std::string>> maiores;
+    if (rankings != nullptr && categoria == "RE") {
+        maiores = rankings->maioresRemetentes(quantidade);
+    } else if (rankings != nullptr && categoria == "DE") {
+        maiores = rankings->maioresDestinatarios(quantidade);
+    }
+
+    saida << maiores.getTamanho() << std::endl;
+    for (int i = 0; i < maiores.getTamanho(); ++i) {
+        saida << maiores.obter(i).chave << " " << maiores.obter(i).contagem << std::endl;
+    }
+}
+
+void FormatadorSaida::escreverRota(int tempo, int idPacote, const Lista<ParadaRota>& paradas, std::ostream& saida) {
+    saida << std::setw(6) << std::setfill('0') << tempo << " RT " << std::setw(3) << std::setfill('0') << idPacote << std::endl;
+
+    saida << paradas.getTamanho() << std::endl;
+    for (const ParadaRota& parada : paradas) {
+        saida << std::setw(7) << std::setfill('0') << parada.chegada << " "
+              << std::setw(3) << std::setfill('0') << parada.armazem << std::endl;
+    }
+}
+
+void FormatadorSaida::escreverTrecho(int tempo, int origem, int destino, const ResumoTrecho* resumo, std::ostream& saida) {
+    saida << std::setw(6) << std::setfill('0') << tempo << " LA "
+          << std::setw(3) << std::setfill('0') << origem << " "
+          << std::setw(3) << std::setfill('0') << destino << std::endl;
+
+    if (resumo == nullptr) {
+        saida << 0 << std::endl;
+        return;
+    }
+
+    saida << resumo->contagem << std::endl;
+    saida << std::fixed << std::setprecision(2)
+          << "min " << resumo->minimo
+          << " media " << resumo->media
+          << " max " << resumo->maximo
+          << " p50 " << resumo->p50
+          << " p90 " << resumo->p90
+          << " p99 " << resumo->p99 << std::endl;
+    saida.unsetf(std::ios::floatfield);
+}
+
+void FormatadorSaida::escreverContagem(int tempo, const long* contagens, std::ostream& saida) {
+    saida << std::setw(6) << std::setfill('0') << tempo << " CE" << std::endl;
+
+    static const char* const nomes[] = {"RG", "AR", "RM", "UR", "TR", "EN"};
+    saida << INDEFINIDO << std::endl;
+    for (int t = RG; t < INDEFINIDO; ++t) {
+        saida << nomes[t] << " " << contagens[t] << std::endl;
+    }
+}
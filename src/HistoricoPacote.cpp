@@ -0,0 +1,348 @@
+#include "../include/HistoricoPacote.hpp"
+
+/**
+ * @file HistoricoPacote.cpp
+ * @brief Implementação da codificação dos históricos de pacotes.
+ */
+
+namespace {
+    const unsigned MASCARA_TIPO = 0x07;
+    const unsigned TEM_ORIGEM = 0x08;
+    const unsigned TEM_DESTINO = 0x10;
+    const unsigned TEM_SECAO = 0x20;
+    const unsigned CAMPOS_EM_NIBBLES = 0x40;
+
+    void escreverVarint(Lista<unsigned char>& saida, uint32_t valor) {
+        while (valor >= 0x80) {
+            saida.adicionar(static_cast<unsigned char>(valor | 0x80));
+            valor >>= 7;
+        }
+        saida.adicionar(static_cast<unsigned char>(valor));
+    }
+
+    uint32_t lerVarint(const unsigned char*& p) {
+        uint32_t valor = 0;
+        int deslocamento = 0;
+        while (*p & 0x80) {
+            valor |= static_cast<uint32_t>(*p++ & 0x7F) << deslocamento;
+            deslocamento += 7;
+        }
+        return valor | (static_cast<uint32_t>(*p++) << deslocamento);
+    }
+
+    uint32_t zigzag(int valor) {
+        return (static_cast<uint32_t>(valor) << 1) ^ static_cast<uint32_t>(valor >> 31);
+    }
+
+    int desfazerZigzag(uint32_t valor) {
+        return static_cast<int>(valor >> 1) ^ -static_cast<int>(valor & 1);
+    }
+
+    void escreverNome(Lista<unsigned char>& saida, const std::string& nome) {
+        escreverVarint(saida, static_cast<uint32_t>(nome.size()));
+        for (size_t i = 0; i < nome.size(); ++i) {
+            saida.adicionar(static_cast<unsigned char>(nome[i]));
+        }
+    }
+
+    void lerNome(const unsigned char*& p, std::string& nome) {
+        uint32_t tamanho = lerVarint(p);
+        nome.assign(reinterpret_cast<const char*>(p), tamanho);
+        p += tamanho;
+    }
+
+    /**
+     * @brief Indica se `a` substitui `b` como último evento: timestamp maior ou, no empate, tipo maior.
+     */
+    bool sucede(const Evento& a, const Evento& b) {
+        return a.dataHora > b.dataHora || (a.dataHora == b.dataHora && a.tipo > b.tipo);
+    }
+}
+
+VisaoHistorico::Leitor VisaoHistorico::inicioBloco(int bloco) const {
+    Leitor leitor;
+    leitor.indice = bloco * PASSO_MARCADORES;
+    if (bloco == 0) {
+        leitor.p = bytes;
+        leitor.tempo = 0;
+        return leitor;
+    }
+    // O primeiro evento do bloco guarda o intervalo desde o anterior; o
+    // timestamp anterior é recuperado a partir do timestamp do marcador.
+    const MarcadorHistorico& marcador = marcadores[bloco - 1];
+    leitor.p = bytes + marcador.deslocamento;
+    const unsigned char* p = leitor.p;
+    leitor.tempo = marcador.tempoInicial - static_cast<int>(lerVarint(p));
+    return leitor;
+}
+
+int VisaoHistorico::buscarBloco(int tempo, bool inclusivo) const {
+    int esquerda = 0;
+    int direita = quantidadeMarcadores(quantidade) - 1;
+    int bloco = 0;
+    while (esquerda <= direita) {
+        int meio = (esquerda + direita) / 2;
+        int inicial = marcadores[meio].tempoInicial;
+        if (inicial < tempo || (inclusivo && inicial == tempo)) {
+            bloco = meio + 1;
+            esquerda = meio + 1;
+        } else {
+            direita = meio - 1;
+        }
+    }
+    return bloco;
+}
+
+void VisaoHistorico::ler(Leitor& leitor, int idPacote, Evento& ev) {
+    const unsigned char*& p = leitor.p;
+    leitor.tempo += static_cast<int>(lerVarint(p));
+    unsigned cabecalho = *p++;
+
+    ev.dataHora = leitor.tempo;
+    ev.tipo = static_cast<TipoEvento>(cabecalho & MASCARA_TIPO);
+    ev.idPacote = idPacote;
+
+    int* campos[3] = {&ev.armazemOrigem, &ev.armazemDestino, &ev.secaoDestino};
+    const unsigned presenca[3] = {TEM_ORIGEM, TEM_DESTINO, TEM_SECAO};
+    bool metadeAlta = false;
+    for (int c = 0; c < 3; ++c) {
+        if (!(cabecalho & presenca[c])) {
+            *campos[c] = -1;
+        } else if (cabecalho & CAMPOS_EM_NIBBLES) {
+            *campos[c] = metadeAlta ? (*p++ >> 4) : (*p & 0x0F);
+            metadeAlta = !metadeAlta;
+        } else {
+            *campos[c] = desfazerZigzag(lerVarint(p));
+        }
+    }
+    if (metadeAlta) {
+        p++; // Número ímpar de campos: a metade alta do último byte não é usada.
+    }
+
+    if (ev.tipo == RG) {
+        lerNome(p, ev.remetente);
+        lerNome(p, ev.destinatario);
+    } else {
+        ev.remetente.clear();
+        ev.destinatario.clear();
+    }
+    leitor.indice++;
+}
+
+int VisaoHistorico::decodificarAte(int tempo, int idPacote, Lista<Evento>& saida) const {
+    Leitor leitor = inicioBloco(0);
+    Evento ev;
+    int decodificados = 0;
+    while (leitor.indice < quantidade) {
+        ler(leitor, idPacote, ev);
+        if (ev.dataHora > tempo) {
+            break; // Os eventos seguintes são ainda mais recentes.
+        }
+        saida.adicionar(ev);
+        decodificados++;
+    }
+    return decodificados;
+}
+
+int VisaoHistorico::decodificarDesdeBloco(int tempo, int idPacote, Lista<Evento>& saida, int& tempoAnterior) const {
+    int bloco = buscarBloco(tempo, true);
+    Leitor leitor = inicioBloco(bloco);
+    tempoAnterior = leitor.tempo;
+    Evento ev;
+    while (leitor.indice < quantidade) {
+        ler(leitor, idPacote, ev);
+        saida.adicionar(ev);
+    }
+    return bloco;
+}
+
+void VisaoHistorico::contarPosteriores(int tempo, long* contagens) const {
+    if (quantidade == 0) {
+        return;
+    }
+    Leitor leitor = inicioBloco(buscarBloco(tempo, true));
+    Evento ev;
+    while (leitor.indice < quantidade) {
+        ler(leitor, -1, ev);
+        if (ev.dataHora > tempo) {
+            contagens[ev.tipo]++;
+        }
+    }
+}
+
+void VisaoHistorico::selecionarParaCliente(int tempo, int idPacote, int parte, SelecaoCliente& selecao) const {
+    if (quantidade == 0) {
+        return;
+    }
+    Evento ev;
+
+    // 1. O último RG até `tempo`. Quase sempre há um só, no início do histórico.
+    if (registros > 0) {
+        Leitor leitor = inicioBloco(0);
+        int indice = -1;
+        Evento registro;
+        while (leitor.indice < quantidade) {
+            ler(leitor, idPacote, ev);
+            if (ev.dataHora > tempo) {
+                break;
+            }
+            if (ev.tipo == RG) {
+                registro = ev;
+                indice = leitor.indice - 1;
+                if (registros == 1) {
+                    break;
+                }
+            }
+        }
+        // Nos empates, o RG de uma parte mais recente vem depois no histórico.
+        if (indice >= 0 && (!selecao.temRegistro || registro.dataHora >= selecao.registro.dataHora)) {
+            selecao.registro = registro;
+            selecao.temRegistro = true;
+            selecao.parteRegistro = parte;
+            selecao.indiceRegistro = indice;
+        }
+    }
+
+    // 2. O último evento até `tempo`, decodificando só a partir do bloco que o contém.
+    //    Se o bloco começa com o timestamp escolhido, eventos com o mesmo
+    //    timestamp (e tipo maior) podem estar em blocos anteriores.
+    int bloco = buscarBloco(tempo, true);
+    for (int tentativa = 0; tentativa < 2; ++tentativa) {
+        Leitor leitor = inicioBloco(bloco);
+        Evento ultimo;
+        int indice = -1;
+        while (leitor.indice < quantidade) {
+            ler(leitor, idPacote, ev);
+            if (ev.dataHora > tempo) {
+                break;
+            }
+            if (indice < 0 || sucede(ev, ultimo)) {
+                ultimo = ev;
+                indice = leitor.indice - 1;
+            }
+        }
+        if (indice < 0) {
+            return;
+        }
+
+        if (tentativa == 0 && bloco > 0 && marcadores[bloco - 1].tempoInicial == ultimo.dataHora) {
+            bloco = buscarBloco(ultimo.dataHora, false);
+            continue;
+        }
+        if (!selecao.temUltimo || sucede(ultimo, selecao.ultimo)) {
+            selecao.ultimo = ultimo;
+            selecao.temUltimo = true;
+            selecao.parteUltimo = parte;
+            selecao.indiceUltimo = indice;
+        }
+        return;
+    }
+}
+
+void HistoricoPacote::acrescentar(const Evento& ev) {
+    int tempoAnterior = quantidade > 0 ? ultimoTempo : 0;
+    if (quantidade > 0 && quantidade % VisaoHistorico::PASSO_MARCADORES == 0) {
+        marcadores.adicionar({static_cast<int32_t>(bytes.getTamanho()), static_cast<int32_t>(ev.dataHora)});
+    }
+    escreverVarint(bytes, static_cast<uint32_t>(ev.dataHora - tempoAnterior));
+
+    const int campos[3] = {ev.armazemOrigem, ev.armazemDestino, ev.secaoDestino};
+    const unsigned presenca[3] = {TEM_ORIGEM, TEM_DESTINO, TEM_SECAO};
+    unsigned cabecalho = static_cast<unsigned>(ev.tipo) & MASCARA_TIPO;
+    bool cabemEmNibbles = true;
+    for (int c = 0; c < 3; ++c) {
+        if (campos[c] != -1) {
+            cabecalho |= presenca[c];
+            if (campos[c] < 0 || campos[c] > 0x0F) {
+                cabemEmNibbles = false;
+            }
+        }
+    }
+    if (cabemEmNibbles) {
+        cabecalho |= CAMPOS_EM_NIBBLES;
+    }
+    bytes.adicionar(static_cast<unsigned char>(cabecalho));
+
+    int nibblePendente = -1;
+    for (int c = 0; c < 3; ++c) {
+        if (campos[c] == -1) {
+            continue;
+        }
+        if (!cabemEmNibbles) {
+            escreverVarint(bytes, zigzag(campos[c]));
+        } else if (nibblePendente < 0) {
+            nibblePendente = campos[c];
+        } else {
+            bytes.adicionar(static_cast<unsigned char>(nibblePendente | (campos[c] << 4)));
+            nibblePendente = -1;
+        }
+    }
+    if (nibblePendente >= 0) {
+        bytes.adicionar(static_cast<unsigned char>(nibblePendente));
+    }
+
+    if (ev.tipo == RG) {
+        escreverNome(bytes, ev.remetente);
+        escreverNome(bytes, ev.destinatario);
+        registros++;
+    }
+    quantidade++;
+    ultimoTempo = ev.dataHora;
+}
+
+void HistoricoPacote::adicionar(const Evento& ev) {
+    if (quantidade == 0 || ev.dataHora >= ultimoTempo) {
+        acrescentar(ev);
+        return;
+    }
+
+    // Evento atrasado: os intervalos seguintes mudam. Os blocos que terminam
+    // antes do seu timestamp ficam intactos; o restante é decodificado, o
+    // histórico é truncado no marcador do bloco e recodificado com o evento
+    // após os de mesmo timestamp.
+    Lista<Evento> eventos;
+    int tempoAnterior = 0;
+    int bloco = visao().decodificarDesdeBloco(ev.dataHora, ev.idPacote, eventos, tempoAnterior);
+    int indice = eventos.getTamanho();
+    while (indice > 0 && eventos[indice - 1].dataHora > ev.dataHora) {
+        indice--;
+    }
+    for (int i = 0; i < eventos.getTamanho(); ++i) {
+        if (eventos[i].tipo == RG) {
+            registros--;
+        }
+    }
+    eventos.inserir(indice, ev);
+
+    bytes.resize(bloco > 0 ? marcadores[bloco - 1].deslocamento : 0);
+    marcadores.resize(bloco > 0 ? bloco - 1 : 0);
+    quantidade = bloco * VisaoHistorico::PASSO_MARCADORES;
+    ultimoTempo = tempoAnterior;
+    for (int i = 0; i < eventos.getTamanho(); ++i) {
+        acrescentar(eventos[i]);
+    }
+}
+
+void HistoricoPacote::limpar() {
+    Lista<unsigned char> bytesVazios;
+    Lista<MarcadorHistorico> marcadoresVazios;
+    bytes.trocar(bytesVazios);
+    marcadores.trocar(marcadoresVazios);
+    quantidade = 0;
+    ultimoTempo = 0;
+    registros = 0;
+}
+
+void HistoricoPacote::trocar(HistoricoPacote& outro) {
+    bytes.trocar(outro.bytes);
+    marcadores.trocar(outro.marcadores);
+    int quantidadeOutro = outro.quantidade;
+    int ultimoTempoOutro = outro.ultimoTempo;
+    int registrosOutro = outro.registros;
+    outro.quantidade = quantidade;
+    outro.ultimoTempo = ultimoTempo;
+    outro.registros = registros;
+    quantidade = quantidadeOutro;
+    ultimoTempo = ultimoTempoOutro;
+    registros = registrosOutro;
+}
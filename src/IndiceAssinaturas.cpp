@@ -0,0 +1,217 @@
+#include "../include/IndiceAssinaturas.hpp"
+#include "../include/RelatorioMemoria.hpp"
+#include <utility>
+
+/**
+ * @file IndiceAssinaturas.cpp
+ * @brief Implementação da classe IndiceAssinaturas.
+ */
+
+namespace {
+    /**
+     * @brief Indica se `a` substitui `b` como último evento, com o mesmo critério da consulta CL.
+     */
+    bool sucede(const Evento& a, const Evento& b) {
+        return a.dataHora > b.dataHora || (a.dataHora == b.dataHora && a.tipo > b.tipo);
+    }
+}
+
+IndiceAssinaturas::IndiceAssinaturas() {}
+
+IndiceAssinaturas::~IndiceAssinaturas() {
+    clientes.paraCada([](const std::string&, AssinaturaCliente*& assinatura) { delete assinatura; });
+    pacotes.paraCada([](int, AssinantesPacote*& assinantes) { delete assinantes; });
+}
+
+IndiceAssinaturas::AssinantesPacote* IndiceAssinaturas::obterPacote(int idPacote, const SelecaoCliente& estado) {
+    AssinantesPacote* assinantes = pacotes.buscar(idPacote);
+    if (assinantes == nullptr) {
+        assinantes = new AssinantesPacote();
+        assinantes->estado = estado;
+        pacotes.inserir(idPacote, assinantes);
+    }
+    return assinantes;
+}
+
+void IndiceAssinaturas::liberarSeVazio(int idPacote, AssinantesPacote* assinantes) {
+    if (!assinantes->assinaturaPacote && assinantes->clientes.getTamanho() == 0) {
+        pacotes.remover(idPacote);
+        delete assinantes;
+    }
+}
+
+bool IndiceAssinaturas::assinarCliente(const std::string& nomeCliente) {
+    if (clientes.buscar(nomeCliente) != nullptr) {
+        return false;
+    }
+    AssinaturaCliente* assinatura = new AssinaturaCliente();
+    assinatura->nomeCliente = nomeCliente;
+    clientes.inserir(nomeCliente, assinatura);
+    return true;
+}
+
+bool IndiceAssinaturas::assinarPacote(int idPacote, const SelecaoCliente& estado) {
+    AssinantesPacote* assinantes = obterPacote(idPacote, estado);
+    if (assinantes->assinaturaPacote) {
+        return false;
+    }
+    assinantes->assinaturaPacote = true;
+    return true;
+}
+
+bool IndiceAssinaturas::cancelarCliente(const std::string& nomeCliente) {
+    AssinaturaCliente* assinatura = clientes.buscar(nomeCliente);
+    if (assinatura == nullptr) {
+        return false;
+    }
+
+    // Retira a assinatura de cada pacote observado, preservando a ordem dos demais assinantes.
+    for (int idPacote : assinatura->pacotes) {
+        AssinantesPacote* assinantes = pacotes.buscar(idPacote);
+        Lista<AssinaturaCliente*, 2>& lista = assinantes->clientes;
+        int destino = 0;
+        for (int i = 0; i < lista.getTamanho(); ++i) {
+            if (lista[i] != assinatura) {
+                lista[destino++] = lista[i];
+            }
+        }
+        lista.resize(destino);
+        liberarSeVazio(idPacote, assinantes);
+    }
+
+    clientes.remover(nomeCliente);
+    delete assinatura;
+    return true;
+}
+
+bool IndiceAssinaturas::cancelarPacote(int idPacote) {
+    AssinantesPacote* assinantes = pacotes.buscar(idPacote);
+    if (assinantes == nullptr || !assinantes->assinaturaPacote) {
+        return false;
+    }
+    assinantes->assinaturaPacote = false;
+    liberarSeVazio(idPacote, assinantes);
+    return true;
+}
+
+bool IndiceAssinaturas::clienteAssinado(const std::string& nomeCliente) const {
+    return clientes.buscar(nomeCliente) != nullptr;
+}
+
+bool IndiceAssinaturas::clienteObservaPacote(const std::string& nomeCliente, int idPacote) const {
+    // Consulta pelo índice reverso, que tem no máximo dois clientes por pacote.
+    AssinaturaCliente* assinatura = clientes.buscar(nomeCliente);
+    AssinantesPacote* assinantes = pacotes.buscar(idPacote);
+    return assinatura != nullptr && assinantes != nullptr && assinantes->clientes.contem(assinatura);
+}
+
+void IndiceAssinaturas::vincularPacote(const std::string& nomeCliente, int idPacote, const SelecaoCliente& estado) {
+    AssinaturaCliente* assinatura = clientes.buscar(nomeCliente);
+    if (assinatura == nullptr) {
+        return;
+    }
+    AssinantesPacote* assinantes = obterPacote(idPacote, estado);
+    if (!assinantes->clientes.contem(assinatura)) {
+        assinantes->clientes.adicionar(assinatura);
+        assinatura->pacotes.adicionar(idPacote);
+    }
+}
+
+void IndiceAssinaturas::registrarEvento(const Evento& ev) {
+    AssinantesPacote* assinantes = pacotes.buscar(ev.idPacote);
+    if (assinantes == nullptr) {
+        return;
+    }
+
+    // Todo evento entra na resposta de PC.
+    if (assinantes->assinaturaPacote) {
+        Notificacao notificacao;
+        notificacao.tipo = ASSINATURA_PACOTE;
+        notificacao.tempo = ev.dataHora;
+        notificacao.idPacote = ev.idPacote;
+        notificacao.eventos.adicionar(ev);
+        pendentes.adicionar(std::move(notificacao));
+    }
+
+    // Na resposta de CL, só se o evento for o novo RG ou o novo último evento do pacote.
+    SelecaoCliente& estado = assinantes->estado;
+    bool novoRegistro = ev.tipo == RG && (!estado.temRegistro || ev.dataHora >= estado.registro.dataHora);
+    bool novoUltimo = !estado.temUltimo || sucede(ev, estado.ultimo);
+    if (novoRegistro) {
+        estado.registro = ev;
+        estado.temRegistro = true;
+    }
+    if (novoUltimo) {
+        estado.ultimo = ev;
+        estado.temUltimo = true;
+    }
+    if (!novoRegistro && !novoUltimo) {
+        return;
+    }
+
+    for (const AssinaturaCliente* assinatura : assinantes->clientes) {
+        Notificacao notificacao;
+        notificacao.tipo = ASSINATURA_CLIENTE;
+        notificacao.tempo = ev.dataHora;
+        notificacao.nomeCliente = assinatura->nomeCliente;
+        notificacao.idPacote = ev.idPacote;
+        notificacao.eventos.adicionar(ev);
+        pendentes.adicionar(std::move(notificacao));
+    }
+}
+
+void IndiceAssinaturas::notificarVinculo(const std::string& nomeCliente, const Evento& ev,
+                                         const SelecaoCliente& estado) {
+    Notificacao notificacao;
+    notificacao.tipo = ASSINATURA_CLIENTE;
+    notificacao.tempo = ev.dataHora;
+    notificacao.nomeCliente = nomeCliente;
+    notificacao.idPacote = ev.idPacote;
+    // O último evento nunca precede o RG no tempo, então a ordem já é a da resposta de CL.
+    if (estado.temRegistro) {
+        notificacao.eventos.adicionar(estado.registro);
+    }
+    if (estado.temUltimo && !estado.mesmoEvento()) {
+        notificacao.eventos.adicionar(estado.ultimo);
+    }
+    pendentes.adicionar(std::move(notificacao));
+}
+
+int IndiceAssinaturas::coletarNotificacoes(Lista<Notificacao>& saida) {
+    int quantidade = pendentes.getTamanho();
+    if (saida.getTamanho() == 0) {
+        // Troca os buffers: a fila fica com o de `saida`, vazio, e o reaproveita.
+        saida.trocar(pendentes);
+    } else {
+        for (Notificacao& notificacao : pendentes) {
+            saida.adicionar(std::move(notificacao));
+        }
+        pendentes.limpar();
+    }
+    return quantidade;
+}
+
+UsoMemoria IndiceAssinaturas::getUsoMemoria() const {
+    UsoMemoria uso = clientes.getUsoMemoria();
+    clientes.paraCada([&uso](const std::string& nomeCliente, const AssinaturaCliente* assinatura) {
+        uso += usoConteudo(nomeCliente);
+        uso += usoObjeto(assinatura);
+        uso += usoConteudo(assinatura->nomeCliente);
+        uso += assinatura->pacotes.getUsoMemoria();
+    });
+    uso += pacotes.getUsoMemoria();
+    pacotes.paraCada([&uso](int, const AssinantesPacote* assinantes) {
+        uso += usoObjeto(assinantes);
+        uso += assinantes->clientes.getUsoMemoria();
+    });
+    uso += pendentes.getUsoMemoria();
+    for (const Notificacao& notificacao : pendentes) {
+        uso += usoConteudo(notificacao.nomeCliente);
+        uso += notificacao.eventos.getUsoMemoria();
+        for (const Evento& ev : notificacao.eventos) {
+            uso += usoConteudo(ev.remetente);
+            uso += usoConteudo(ev.destinatario);
+        }
+    }
+    return uso;
+}
@@ -0,0 +1,114 @@
+#include "../include/IndiceRotas.hpp"
+#include "../include/RelatorioMemoria.hpp"
+
+/**
+ * @file IndiceRotas.cpp
+ * @brief Implementação da classe IndiceRotas.
+ */
+
+IndiceRotas::IndiceRotas() {
+    rotas = new Mapa<int, RotaPacote*>();
+    trechos = new Mapa<long long, EstatisticasTrecho*>();
+}
+
+IndiceRotas::~IndiceRotas() {
+    rotas->paraCada([](int, RotaPacote*& rota) { delete rota; });
+    for (EstatisticasTrecho* trecho : todosOsTrechos) {
+        delete trecho;
+    }
+    delete rotas;
+    delete trechos;
+}
+
+long long IndiceRotas::chaveTrecho(int origem, int destino) {
+    return static_cast<long long>(static_cast<unsigned long long>(static_cast<unsigned>(origem)) << 32 |
+                                  static_cast<unsigned>(destino));
+}
+
+void IndiceRotas::adicionarParada(RotaPacote* rota, int armazem, int chegada) {
+    int n = rota->paradas.getTamanho();
+    if (n > 0 && rota->paradas.obter(n - 1).armazem == armazem) {
+        return;
+    }
+    rota->paradas.adicionar({armazem, chegada});
+}
+
+void IndiceRotas::registrarEvento(const Evento& ev) {
+    RotaPacote* rota = rotas->buscar(ev.idPacote);
+    if (rota == nullptr) {
+        rota = new RotaPacote();
+        rotas->inserir(ev.idPacote, rota);
+    }
+
+    switch (ev.tipo) {
+        case RG:
+            adicionarParada(rota, ev.armazemOrigem, ev.dataHora);
+            break;
+        case TR:
+            rota->origemTransito = ev.armazemOrigem;
+            rota->destinoTransito = ev.armazemDestino;
+            rota->inicioTransito = ev.dataHora;
+            break;
+        case AR: {
+            // O primeiro AR após um TR encerra o trânsito e alimenta o trecho.
+            if (rota->origemTransito >= 0) {
+                long long chave = chaveTrecho(rota->origemTransito, rota->destinoTransito);
+                EstatisticasTrecho* trecho = trechos->buscar(chave);
+                if (trecho == nullptr) {
+                    trecho = new EstatisticasTrecho();
+                    trechos->inserir(chave, trecho);
+                    todosOsTrechos.adicionar(trecho);
+                }
+
+                int duracao = ev.dataHora - rota->inicioTransito;
+                if (trecho->contagem == 0 || duracao < trecho->minimo) trecho->minimo = duracao;
+                if (trecho->contagem == 0 || duracao > trecho->maximo) trecho->maximo = duracao;
+                trecho->contagem++;
+                trecho->soma += duracao;
+                trecho->quantis.adicionar(duracao);
+
+                rota->origemTransito = -1;
+            }
+            adicionarParada(rota, ev.armazemOrigem, ev.dataHora);
+            break;
+        }
+        case RM:
+        case UR: // Rearmazenamento na origem, não uma chegada: o trânsito continua aberto.
+        case EN:
+        case INDEFINIDO:
+            break;
+    }
+}
+
+const RotaPacote* IndiceRotas::obterRota(int idPacote) const {
+    return rotas->buscar(idPacote);
+}
+
+void IndiceRotas::removerRota(int idPacote) {
+    RotaPacote* rota = rotas->buscar(idPacote);
+    if (rota != nullptr) {
+        rotas->remover(idPacote);
+        delete rota;
+    }
+}
+
+const EstatisticasTrecho* IndiceRotas::obterTrecho(int origem, int destino) const {
+    return trechos->buscar(chaveTrecho(origem, destino));
+}
+
+UsoMemoria IndiceRotas::getUsoMemoria() const {
+    UsoMemoria uso = usoObjeto(rotas);
+    uso += rotas->getUsoMemoria();
+    rotas->paraCada([&uso](int, const RotaPacote* rota) {
+        uso += usoObjeto(rota);
+        uso += rota->paradas.getUsoMemoria();
+    });
+    uso += usoObjeto(trechos);
+    uso += trechos->getUsoMemoria();
+    uso += todosOsTrechos.getUsoMemoria();
+    for (const EstatisticasTrecho* trecho : todosOsTrechos) {
+        uso += usoObjeto(trecho);
+        uso += trecho->quantis.getUsoMemoria();
+    }
+    return uso;
+}
@@ -0,0 +1,562 @@
+#include "../include/MotorLogistico.hpp"
+#include "../include/Rastreamento.hpp"
+#include <climits>
+
+/**
+ * @file MotorLogistico.cpp
+ * @brief Implementação da classe MotorLogistico.
+ */
+
+MotorLogistico::MotorLogistico(const OpcoesMotor& opcoes) {
+    mapaPacotes = new Mapa<int, EventosPacote*>();
+    mapaClientes = new Mapa<std::string, PacotesCliente*>();
+    rankings = nullptr;
+    if (opcoes.manterRankings) {
+        rankings = new RankingsAtividade(opcoes.capacidadeRanking, opcoes.rankingAproximado);
+    }
+    indiceRotas = new IndiceRotas();
+    contadorVersoes = 0;
+
+    janelaRetencao = opcoes.janelaRetencao;
+    maiorTempo = 0;
+    inicioEntregas = 0;
+    eventosAArquivar = 0;
+    eventosResidentes = 0;
+    for (int t = 0; t <= INDEFINIDO; ++t) {
+        contagensArquivadas[t] = 0;
+        contagensResidentes[t] = 0;
+    }
+    pacotesArquivados = 0;
+    eventosCompactados = 0;
+
+    assinaturas = nullptr;
+
+    segmentos = nullptr;
+    limiteEventosResidentes = 0;
+    if (opcoes.memoriaMaxima > 0) {
+        segmentos = new ColecaoSegmentos(opcoes.diretorioSegmentos);
+        long limite = opcoes.memoriaMaxima / BYTES_POR_EVENTO;
+        limiteEventosResidentes = limite < 1 ? 1 : (limite > 0x7fffffffL ? 0x7fffffff : static_cast<int>(limite));
+    }
+}
+
+MotorLogistico::~MotorLogistico() {
+    // 1. Libera os históricos de eventos dentro do mapa de pacotes.
+    mapaPacotes->paraCada([](int, EventosPacote*& pacote) { delete pacote; });
+
+    // 2. Libera os objetos PacotesCliente dentro do mapa de clientes.
+    mapaClientes->paraCada([](const std::string&, PacotesCliente*& cliente) { delete cliente; });
+
+    // 3. Libera os próprios mapas e os índices auxiliares.
+    delete mapaPacotes;
+    delete mapaClientes;
+    delete rankings;
+    delete indiceRotas;
+    delete segmentos;
+    delete assinaturas;
+}
+
+void MotorLogistico::medirMemoria(RelatorioMemoria& relatorio) const {
+
+    relatorio.registrar("package map", mapaPacotes->getUsoMemoria(), static_cast<long>(mapaPacotes->getTamanho()));
+    UsoMemoria registrosPacotes;
+    UsoMemoria historicos;
+    long eventosResidentes = 0;
+    mapaPacotes->paraCada([&](int, const EventosPacote* pacote) {
+        registrosPacotes += usoObjeto(pacote);
+        registrosPacotes += pacote->clientes.getUsoMemoria();
+        historicos += pacote->historico.getUsoMemoria();
+        eventosResidentes += pacote->historico.getQuantidade();
+    });
+    relatorio.registrar("package records", registrosPacotes, static_cast<long>(mapaPacotes->getTamanho()));
+    relatorio.registrar("package histories", historicos, eventosResidentes);
+
+    // As chaves do mapa são os nomes dos clientes.
+    UsoMemoria nomes;
+    UsoMemoria listasClientes;
+    mapaClientes->paraCada([&](const std::string& nome, const PacotesCliente* cliente) {
+        nomes += usoConteudo(nome);
+        listasClientes += usoObjeto(cliente);
+        listasClientes += cliente->enviados.getUsoMemoria();
+        listasClientes += cliente->aReceber.getUsoMemoria();
+    });
+    long clientes = static_cast<long>(mapaClientes->getTamanho());
+    relatorio.registrar("client map", mapaClientes->getUsoMemoria(), clientes);
+    relatorio.registrar("client names", nomes, clientes);
+    relatorio.registrar("client package lists", listasClientes, clientes);
+
+    relatorio.registrar("routes", indiceRotas->getUsoMemoria(), static_cast<long>(indiceRotas->getQuantidadeRotas()));
+    if (rankings != nullptr) {
+        relatorio.registrar("rankings", rankings->getUsoMemoria(), 3);
+    }
+
+    UsoMemoria retencao = entregas.getUsoMemoria();
+    retencao += pacotesAArquivar.getUsoMemoria();
+    relatorio.registrar("retention queues", retencao,
+                        entregas.getTamanho() - inicioEntregas + pacotesAArquivar.getTamanho());
+    if (assinaturas != nullptr) {
+        relatorio.registrar("subscriptions", assinaturas->getUsoMemoria(),
+                            static_cast<long>(assinaturas->getPacotesObservados()));
+    }
+}
+
+void MotorLogistico::vincularCliente(EventosPacote* pacote, PacotesCliente* cliente) {
+    if (!pacote->clientes.contem(cliente)) {
+        pacote->clientes.adicionar(cliente);
+    }
+}
+
+bool MotorLogistico::ingerir(const Evento& ev) {
+    if (ev.tipo == INDEFINIDO) {
+        return false;
+    }
+
+    EventosPacote* pacote = mapaPacotes->buscar(ev.idPacote);
+    if (pacote == nullptr) {
+        pacote = new EventosPacote(ev.idPacote);
+        mapaPacotes->inserir(ev.idPacote, pacote);
+    }
+
+    if (ev.tipo == RG) {
+        // Processa remetente
+        PacotesCliente* pacotesRemetente = mapaClientes->buscar(ev.remetente);
+        if (pacotesRemetente == nullptr) {
+            pacotesRemetente = new PacotesCliente();
+            mapaClientes->inserir(ev.remetente, pacotesRemetente);
+        }
+        if (!pacotesRemetente->enviados.contem(ev.idPacote)) {
+            pacotesRemetente->enviados.adicionar(ev.idPacote);
+        }
+        vincularCliente(pacote, pacotesRemetente);
+
+        // Processa destinatário
+        PacotesCliente* pacotesDestinatario = mapaClientes->buscar(ev.destinatario);
+        if (pacotesDestinatario == nullptr) {
+            pacotesDestinatario = new PacotesCliente();
+            mapaClientes->inserir(ev.destinatario, pacotesDestinatario);
+        }
+        if (!pacotesDestinatario->aReceber.contem(ev.idPacote)) {
+            pacotesDestinatario->aReceber.adicionar(ev.idPacote);
+        }
+        vincularCliente(pacote, pacotesDestinatario);
+    }
+
+    if (rankings != nullptr) {
+        rankings->registrarEvento(ev);
+    }
+
+    contagensResidentes[ev.tipo]++;
+    eventosResidentes++;
+    if (ev.dataHora > maiorTempo) {
+        maiorTempo = ev.dataHora;
+    }
+    indiceRotas->registrarEvento(ev);
+
+    // O histórico fica em ordem de tempo: um evento atrasado é inserido após os
+    // de mesmo timestamp.
+    pacote->historico.adicionar(ev);
+
+    // O evento muda o resultado de CL de todos os clientes que listam o pacote.
+    // O último evento da lista (e não o atual) cobre eventos anteriores ao RG.
+    long versao = ++contadorVersoes;
+    int ultimoTempoPacote = pacote->historico.getUltimoTempo();
+    for (PacotesCliente* cliente : pacote->clientes) {
+        cliente->versao = versao;
+        if (ultimoTempoPacote > cliente->ultimoTempo) {
+            cliente->ultimoTempo = ultimoTempoPacote;
+        }
+    }
+
+    if (assinaturas != nullptr) {
+        notificarAssinantes(ev);
+    }
+
+    if (janelaRetencao >= 0) {
+        if (ev.tipo == EN) {
+            entregas.adicionar({ev.idPacote, ev.dataHora});
+        }
+        aplicarRetencao();
+    }
+
+    if (segmentos != nullptr && eventosResidentes >= limiteEventosResidentes) {
+        despejar();
+    }
+    return true;
+}
+
+void MotorLogistico::notificarAssinantes(const Evento& ev) {
+    assinaturas->registrarEvento(ev);
+    if (ev.tipo == RG) {
+        vincularAssinante(ev.remetente, ev);
+        vincularAssinante(ev.destinatario, ev);
+    }
+}
+
+void MotorLogistico::vincularAssinante(const std::string& nomeCliente, const Evento& ev) {
+    if (!assinaturas->clienteAssinado(nomeCliente) || assinaturas->clienteObservaPacote(nomeCliente, ev.idPacote)) {
+        return;
+    }
+    // O pacote entra na resposta de CL do cliente com o RG e o último evento.
+    SelecaoCliente estado;
+    selecionarPacote(INT_MAX, ev.idPacote, estado);
+    assinaturas->vincularPacote(nomeCliente, ev.idPacote, estado);
+    assinaturas->notificarVinculo(nomeCliente, ev, estado);
+}
+
+bool MotorLogistico::assinarCliente(const std::string& nomeCliente) {
+    if (assinaturas == nullptr) {
+        assinaturas = new IndiceAssinaturas();
+    }
+    if (!assinaturas->assinarCliente(nomeCliente)) {
+        return false;
+    }
+
+    PacotesCliente* pacotesCliente = mapaClientes->buscar(nomeCliente);
+    if (pacotesCliente != nullptr) {
+        Lista<int> ids;
+        coletarIdsCliente(pacotesCliente, ids);
+        for (int idPacote : ids) {
+            SelecaoCliente estado;
+            selecionarPacote(INT_MAX, idPacote, estado);
+            assinaturas->vincularPacote(nomeCliente, idPacote, estado);
+        }
+    }
+    return true;
+}
+
+bool MotorLogistico::assinarPacote(int idPacote) {
+    if (assinaturas == nullptr) {
+        assinaturas = new IndiceAssinaturas();
+    }
+    SelecaoCliente estado;
+    selecionarPacote(INT_MAX, idPacote, estado);
+    return assinaturas->assinarPacote(idPacote, estado);
+}
+
+bool MotorLogistico::cancelarAssinaturaCliente(const std::string& nomeCliente) {
+    return assinaturas != nullptr && assinaturas->cancelarCliente(nomeCliente);
+}
+
+bool MotorLogistico::cancelarAssinaturaPacote(int idPacote) {
+    return assinaturas != nullptr && assinaturas->cancelarPacote(idPacote);
+}
+
+int MotorLogistico::coletarNotificacoes(Lista<Notificacao>& notificacoes) {
+    return assinaturas != nullptr ? assinaturas->coletarNotificacoes(notificacoes) : 0;
+}
+
+void MotorLogistico::aplicarRetencao() {
+    while (inicioEntregas < entregas.getTamanho() &&
+           entregas.obter(inicioEntregas).tempo < maiorTempo - janelaRetencao) {
+        int idPacote = entregas.obter(inicioEntregas++).idPacote;
+        EventosPacote* pacote = mapaPacotes->buscar(idPacote);
+        if (pacote != nullptr) {
+            pacotesAArquivar.adicionar(idPacote);
+            if (pacote->historico.getQuantidade() > 2) {
+                eventosAArquivar += pacote->historico.getQuantidade() - 2;
+            }
+        }
+    }
+
+    // Descarta o prefixo já consumido da fila quando ele domina a lista.
+    if (inicioEntregas > 1024 && inicioEntregas * 2 > entregas.getTamanho()) {
+        Lista<Entrega> pendentes;
+        for (int i = inicioEntregas; i < entregas.getTamanho(); ++i) {
+            pendentes.adicionar(entregas.obter(i));
+        }
+        entregas.trocar(pendentes);
+        inicioEntregas = 0;
+    }
+
+    if (eventosAArquivar > 0 && eventosAArquivar * 4 >= eventosResidentes) {
+        compactar();
+    }
+}
+
+void MotorLogistico::compactar() {
+    long versao = ++contadorVersoes;
+    for (int i = 0; i < pacotesAArquivar.getTamanho(); ++i) {
+        int idPacote = pacotesAArquivar.obter(i);
+        EventosPacote* pacote = mapaPacotes->buscar(idPacote);
+
+        // 1. Mantém o registro (RG) e o último evento, escolhidos como na consulta CL.
+        VisaoHistorico visao = pacote->historico.visao();
+        SelecaoCliente selecao;
+        visao.selecionarParaCliente(INT_MAX, idPacote, 0, selecao);
+        Lista<Evento> todos;
+        visao.decodificarAte(INT_MAX, idPacote, todos);
+
+        HistoricoPacote mantido;
+        for (int j = 0; j < todos.getTamanho(); ++j) {
+            const Evento& ev = todos[j];
+            if ((selecao.temRegistro && selecao.indiceRegistro == j) ||
+                (selecao.temUltimo && selecao.indiceUltimo == j)) {
+                mantido.adicionar(ev);
+            } else {
+                contagensResidentes[ev.tipo]--;
+                eventosResidentes--;
+                contagensArquivadas[ev.tipo]++;
+                eventosCompactados++;
+            }
+        }
+        if (mantido.getQuantidade() < todos.getTamanho()) {
+            pacotesArquivados++;
+        }
+        pacote->historico.trocar(mantido);
+        indiceRotas->removerRota(idPacote);
+
+        for (int j = 0; j < pacote->clientes.getTamanho(); ++j) {
+            pacote->clientes.obter(j)->versao = versao;
+        }
+    }
+
+    Lista<int> vazia;
+    pacotesAArquivar.trocar(vazia);
+    eventosAArquivar = 0;
+}
+
+namespace {
+    bool precedePorId(EventosPacote* const& a, EventosPacote* const& b) {
+        return a->idPacote < b->idPacote;
+    }
+}
+
+void MotorLogistico::despejar() {
+    // 1. Ordena por ID os pacotes com eventos residentes, como o segmento exige.
+    Lista<EventosPacote*> residentes;
+    mapaPacotes->paraCada([&residentes](int, EventosPacote* pacote) {
+        if (pacote->historico.getQuantidade() > 0) {
+            residentes.adicionar(pacote);
+        }
+    });
+    residentes.ordenarMesclando(precedePorId);
+
+    Lista<int> ids;
+    Lista<VisaoHistorico> historicos;
+    for (int i = 0; i < residentes.getTamanho(); ++i) {
+        ids.adicionar(residentes.obter(i)->idPacote);
+        historicos.adicionar(residentes.obter(i)->historico.visao());
+    }
+
+    // 2. Grava o segmento, copiando os históricos já codificados, e libera a memória.
+    segmentos->despejar(ids, historicos);
+    for (int i = 0; i < residentes.getTamanho(); ++i) {
+        residentes.obter(i)->historico.limpar();
+    }
+    eventosResidentes = 0;
+    for (int t = 0; t <= INDEFINIDO; ++t) {
+        contagensResidentes[t] = 0;
+    }
+    eventosAArquivar = 0;
+}
+
+int MotorLogistico::ingerirLote(const Evento* lote, int quantidade) {
+    int ingeridos = 0;
+    for (int i = 0; i < quantidade; ++i) {
+        if (ingerir(lote[i])) {
+            ingeridos++;
+        }
+    }
+    return ingeridos;
+}
+
+void MotorLogistico::coletarHistorico(int tempo, int idPacote, Lista<Evento>& saida) const {
+    int partes = segmentos != nullptr ? segmentos->coletarPacote(idPacote, tempo, saida) : 0;
+    EventosPacote* pacote = mapaPacotes->buscar(idPacote);
+    if (pacote != nullptr && pacote->historico.visao().decodificarAte(tempo, idPacote, saida) > 0) {
+        partes++;
+    }
+    // Cada parte está em ordem de tempo e de ingestão nos empates; a ordenação
+    // estável reproduz a ordem que o histórico teria se fosse todo residente.
+    if (partes > 1) {
+        saida.ordenarMesclando(precedeNoTempo);
+    }
+}
+
+Lista<Evento> MotorLogistico::consultarPacote(int tempo, int idPacote) const {
+    Lista<Evento> resultado;
+    coletarHistorico(tempo, idPacote, resultado);
+    return resultado;
+}
+
+int MotorLogistico::consultarPacote(int tempo, int idPacote, CallbackEvento callback, void* contexto) const {
+    Lista<Evento> historico;
+    coletarHistorico(tempo, idPacote, historico);
+    for (const Evento& ev : historico) {
+        callback(ev, contexto);
+    }
+    return historico.getTamanho();
+}
+
+void MotorLogistico::coletarIdsCliente(const PacotesCliente* pacotesCliente, Lista<int>& todosOsIds) {
+    // Coleta IDs de pacotes enviados
+    for (int idPacote : pacotesCliente->enviados) {
+        todosOsIds.adicionar(idPacote);
+    }
+    // Coleta IDs de pacotes a receber
+    for (int idPacote : pacotesCliente->aReceber) {
+        if (!todosOsIds.contem(idPacote)) { // Evita duplicatas
+            todosOsIds.adicionar(idPacote);
+        }
+    }
+}
+
+void MotorLogistico::selecionarPacote(int tempo, int idPacote, SelecaoCliente& selecao) const {
+    // Encontra o evento de registro (RG) e o último evento no tempo, com
+    // desempate pelo tipo de evento, em cada parte do histórico.
+    int parteResidente = segmentos != nullptr ? segmentos->getQuantidadeSegmentos() : 0;
+    if (segmentos != nullptr) {
+        segmentos->selecionarParaCliente(idPacote, tempo, selecao);
+    }
+    EventosPacote* pacote = mapaPacotes->buscar(idPacote);
+    if (pacote != nullptr) {
+        pacote->historico.visao().selecionarParaCliente(tempo, idPacote, parteResidente, selecao);
+    }
+}
+
+void MotorLogistico::selecionarEventosCliente(int tempo, const std::string& nomeCliente,
+                                              Lista<Evento>& eventosResultantes) const {
+    PacotesCliente* pacotesCliente = mapaClientes->buscar(nomeCliente);
+    if (pacotesCliente == nullptr) {
+        return;
+    }
+
+    Lista<int> todosOsIds;
+    coletarIdsCliente(pacotesCliente, todosOsIds);
+
+    for (int idPacote : todosOsIds) {
+        SelecaoCliente selecao;
+        selecionarPacote(tempo, idPacote, selecao);
+
+        // Adiciona o evento de registro e o último evento, sem repetir o mesmo evento
+        if (selecao.temRegistro) {
+            eventosResultantes.adicionar(selecao.registro);
+        }
+        if (selecao.temUltimo && !selecao.mesmoEvento()) {
+            eventosResultantes.adicionar(selecao.ultimo);
+        }
+    }
+
+    ordenarEventos(eventosResultantes);
+}
+
+Lista<Evento> MotorLogistico::consultarCliente(int tempo, const std::string& nomeCliente) const {
+    Lista<Evento> resultado;
+    selecionarEventosCliente(tempo, nomeCliente, resultado);
+    return resultado;
+}
+
+int MotorLogistico::consultarCliente(int tempo, const std::string& nomeCliente,
+                                     CallbackEvento callback, void* contexto) const {
+    Lista<Evento> selecionados;
+    selecionarEventosCliente(tempo, nomeCliente, selecionados);
+    for (const Evento& ev : selecionados) {
+        callback(ev, contexto);
+    }
+    return selecionados.getTamanho();
+}
+
+bool MotorLogistico::obterVersaoCliente(const std::string& nomeCliente, VersaoCliente& versao) const {
+    PacotesCliente* pacotesCliente = mapaClientes->buscar(nomeCliente);
+    if (pacotesCliente == nullptr) {
+        return false;
+    }
+    versao.versao = pacotesCliente->versao;
+    versao.ultimoTempo = pacotesCliente->ultimoTempo;
+    return true;
+}
+
+Lista<ItemRanking<std::string>> MotorLogistico::consultarRankingRemetentes(int quantidade) const {
+    if (rankings == nullptr) {
+        return Lista<ItemRanking<std::string>>();
+    }
+    return rankings->maioresRemetentes(quantidade);
+}
+
+Lista<ItemRanking<std::string>> MotorLogistico::consultarRankingDestinatarios(int quantidade) const {
+    if (rankings == nullptr) {
+        return Lista<ItemRanking<std::string>>();
+    }
+    return rankings->maioresDestinatarios(quantidade);
+}
+
+Lista<ItemRanking<int>> MotorLogistico::consultarRankingArmazens(int quantidade) const {
+    if (rankings == nullptr) {
+        return Lista<ItemRanking<int>>();
+    }
+    return rankings->maioresArmazens(quantidade);
+}
+
+Lista<ParadaRota> MotorLogistico::consultarRota(int tempo, int idPacote) const {
+    Lista<ParadaRota> resultado;
+    const RotaPacote* rota = indiceRotas->obterRota(idPacote);
+    if (rota == nullptr) {
+        return resultado;
+    }
+
+    // As paradas estão em ordem de chegada, então basta copiar o prefixo até `tempo`.
+    for (int i = 0; i < rota->paradas.getTamanho() && rota->paradas.obter(i).chegada <= tempo; ++i) {
+        resultado.adicionar(rota->paradas.obter(i));
+    }
+    return resultado;
+}
+
+bool MotorLogistico::consultarTrecho(int origem, int destino, ResumoTrecho& resumo) const {
+    const EstatisticasTrecho* trecho = indiceRotas->obterTrecho(origem, destino);
+    if (trecho == nullptr) {
+        return false;
+    }
+    resumo = trecho->resumo();
+    return true;
+}
+
+bool MotorLogistico::obterEstatisticasTrecho(int origem, int destino, EstatisticasTrecho& estatisticas) const {
+    const EstatisticasTrecho* trecho = indiceRotas->obterTrecho(origem, destino);
+    if (trecho == nullptr) {
+        return false;
+    }
+    estatisticas = *trecho;
+    return true;
+}
+
+void MotorLogistico::contarEventos(int tempo, long* contagens) const {
+    // Os eventos arquivados são anteriores à janela de retenção, logo a qualquer consulta atual.
+    for (int t = 0; t <= INDEFINIDO; ++t) {
+        contagens[t] = contagensResidentes[t] + contagensArquivadas[t];
+    }
+
+    // Uma consulta anterior ao último evento ingerido desconta os eventos
+    // residentes posteriores a ela, lidos só do fim de cada histórico.
+    if (tempo < maiorTempo) {
+        long posteriores[INDEFINIDO + 1] = {0};
+        mapaPacotes->paraCada([&](int, const EventosPacote* pacote) {
+            if (pacote->historico.getQuantidade() > 0 && pacote->historico.getUltimoTempo() > tempo) {
+                pacote->historico.visao().contarPosteriores(tempo, posteriores);
+            }
+        });
+        for (int t = 0; t <= INDEFINIDO; ++t) {
+            contagens[t] -= posteriores[t];
+        }
+    }
+
+    if (segmentos != nullptr) {
+        segmentos->contarEventos(tempo, contagens);
+    }
+}
+
+// Função de comparação estática para o método de ordenação.
+bool MotorLogistico::compararEventos(const Evento& a, const Evento& b) {
+    if (a.dataHora != b.dataHora) {
+        return a.dataHora < b.dataHora;
+    }
+    return a.idPacote < b.idPacote;
+}
+
+void MotorLogistico::ordenarEventos(Lista<Evento>& lista) {
+    EscopoRastreamento escopo("ordenarEventos", "eventos", lista.getTamanho());
+    lista.ordenarMesclando(compararEventos);
+}
+
+bool MotorLogistico::precedeNoTempo(const Evento& a, const Evento& b) {
+    return a.dataHora < b.dataHora;
+}
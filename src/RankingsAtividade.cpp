@@ -0,0 +1,60 @@
+#include "../include/RankingsAtividade.hpp"
+
+/**
+ * @file RankingsAtividade.cpp
+ * @brief Implementação da classe RankingsAtividade.
+ */
+
+RankingsAtividade::RankingsAtividade(int capacidade, bool aproximado) {
+    rankingRemetentes = new RankingTopK<std::string>(capacidade, aproximado);
+    rankingDestinatarios = new RankingTopK<std::string>(capacidade, aproximado);
+    rankingArmazens = new RankingTopK<int>(capacidade, aproximado);
+}
+
+RankingsAtividade::~RankingsAtividade() {
+    delete rankingRemetentes;
+    delete rankingDestinatarios;
+    delete rankingArmazens;
+}
+
+void RankingsAtividade::registrarEvento(const Evento& ev) {
+    switch (ev.tipo) {
+        case RG:
+            rankingRemetentes->incrementar(ev.remetente);
+            rankingDestinatarios->incrementar(ev.destinatario);
+            break;
+        case AR:
+        case TR:
+            rankingArmazens->incrementar(ev.armazemOrigem);
+            break;
+        case EN:
+            rankingArmazens->incrementar(ev.armazemDestino);
+            break;
+        case RM:
+        case UR:
+        case INDEFINIDO:
+            break;
+    }
+}
+
+Lista<ItemRanking<std::string>> RankingsAtividade::maioresRemetentes(int quantidade) const {
+    return rankingRemetentes->obterMaiores(quantidade);
+}
+
+Lista<ItemRanking<std::string>> RankingsAtividade::maioresDestinatarios(int quantidade) const {
+    return rankingDestinatarios->obterMaiores(quantidade);
+}
+
+Lista<ItemRanking<int>> RankingsAtividade::maioresArmazens(int quantidade) const {
+    return rankingArmazens->obterMaiores(quantidade);
+}
+
+UsoMemoria RankingsAtividade::getUsoMemoria() const {
+    UsoMemoria uso = usoObjeto(rankingRemetentes);
+    uso += rankingRemetentes->getUsoMemoria();
+    uso += usoObjeto(rankingDestinatarios);
+    uso += rankingDestinatarios->getUsoMemoria();
+    uso += usoObjeto(rankingArmazens);
+    uso += rankingArmazens->getUsoMemoria();
+    return uso;
+}
@@ -0,0 +1,136 @@
+#include "../include/Rastreamento.hpp"
+#include "../include/Lista.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+/**
+ * @file Rastreamento.cpp
+ * @brief Implementação da gravação e da exportação de spans.
+ */
+
+namespace {
+    /**
+     * @brief Os spans de uma thread. Só a thread dona escreve; `gravados` publica os registros.
+     */
+    struct AnelSpans {
+        RegistroSpan registros[Rastreamento::CAPACIDADE_ANEL];
+        std::atomic<uint64_t> gravados;
+        int idThread;
+        std::string nomeThread;
+
+        explicit AnelSpans(int idThread) : gravados(0), idThread(idThread) {}
+    };
+
+    // Os anéis vivem até o fim do processo, pois a exportação pode ocorrer
+    // depois que as threads que os gravaram terminaram.
+    std::mutex travaAneis; ///< Protege apenas a criação de anéis e a exportação.
+    Lista<AnelSpans*> aneis;
+    thread_local AnelSpans* anelDaThread = nullptr;
+    std::chrono::steady_clock::time_point instanteZero;
+
+    AnelSpans* anelAtual() {
+        if (anelDaThread == nullptr) {
+            std::lock_guard<std::mutex> trava(travaAneis);
+            anelDaThread = new AnelSpans(aneis.getTamanho() + 1);
+            aneis.adicionar(anelDaThread);
+        }
+        return anelDaThread;
+    }
+
+    /**
+     * @brief Escreve uma string JSON; os nomes gravados são literais do programa.
+     */
+    void escreverTexto(std::ostream& saida, const std::string& texto) {
+        saida << '"';
+        for (size_t i = 0; i < texto.size(); ++i) {
+            if (texto[i] == '"' || texto[i] == '\\') {
+                saida << '\\';
+            }
+            saida << texto[i];
+        }
+        saida << '"';
+    }
+}
+
+std::atomic<bool> Rastreamento::ativado(false);
+
+void Rastreamento::ativar() {
+    instanteZero = std::chrono::steady_clock::now();
+    ativado.store(true, std::memory_order_release);
+}
+
+int64_t Rastreamento::agora() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - instanteZero)
+        .count();
+}
+
+void Rastreamento::registrar(const char* nome, int64_t inicio, int64_t fim, const char* nomeArgumento,
+                             long argumento) {
+    AnelSpans* anel = anelAtual();
+    uint64_t indice = anel->gravados.load(std::memory_order_relaxed);
+    RegistroSpan& registro = anel->registros[indice % CAPACIDADE_ANEL];
+    registro.nome = nome;
+    registro.nomeArgumento = nomeArgumento;
+    registro.argumento = argumento;
+    registro.inicio = inicio;
+    registro.duracao = fim - inicio;
+    anel->gravados.store(indice + 1, std::memory_order_release);
+}
+
+void Rastreamento::nomearThread(const std::string& nome) {
+    if (ativo()) {
+        anelAtual()->nomeThread = nome;
+    }
+}
+
+bool Rastreamento::exportar(const std::string& caminho) {
+    std::ofstream saida(caminho);
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar o arquivo de rastreamento: " << caminho << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> trava(travaAneis);
+    saida << std::fixed << std::setprecision(3);
+    saida << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool primeiro = true;
+    uint64_t sobrescritos = 0;
+    for (const AnelSpans* anel : aneis) {
+        if (!anel->nomeThread.empty()) {
+            saida << (primeiro ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                  << anel->idThread << ",\"args\":{\"name\":";
+            escreverTexto(saida, anel->nomeThread);
+            saida << "}}";
+            primeiro = false;
+        }
+
+        uint64_t gravados = anel->gravados.load(std::memory_order_acquire);
+        uint64_t inicio = gravados > static_cast<uint64_t>(CAPACIDADE_ANEL) ? gravados - CAPACIDADE_ANEL : 0;
+        sobrescritos += inicio;
+        for (uint64_t i = inicio; i < gravados; ++i) {
+            const RegistroSpan& registro = anel->registros[i % CAPACIDADE_ANEL];
+            // O formato usa microssegundos; as frações preservam a resolução em ns.
+            saida << (primeiro ? "\n" : ",\n") << "{\"name\":";
+            escreverTexto(saida, registro.nome);
+            saida << ",\"cat\":\"tp3\",\"ph\":\"X\",\"pid\":1,\"tid\":" << anel->idThread
+                  << ",\"ts\":" << registro.inicio / 1000.0 << ",\"dur\":" << registro.duracao / 1000.0;
+            if (registro.nomeArgumento != nullptr) {
+                saida << ",\"args\":{";
+                escreverTexto(saida, registro.nomeArgumento);
+                saida << ":" << registro.argumento << "}";
+            }
+            saida << "}";
+            primeiro = false;
+        }
+    }
+    saida << "\n]}\n";
+
+    if (sobrescritos > 0) {
+        std::cerr << "Rastreamento: " << sobrescritos << " spans antigos sobrescritos (" << CAPACIDADE_ANEL
+                  << " por thread)" << std::endl;
+    }
+    return saida.good();
+}
@@ -0,0 +1,84 @@
+#include "../include/RelatorioMemoria.hpp"
+#include <cstring>
+#include <fstream>
+
+/**
+ * @file RelatorioMemoria.cpp
+ * @brief Implementação da contabilidade de memória e do contador de `AlocadorPadrao`.
+ */
+
+std::atomic<bool> ContadorAlocacoes::ativado(false);
+std::atomic<long> ContadorAlocacoes::bytesVivos(0);
+std::atomic<long> ContadorAlocacoes::picoBytes(0);
+std::atomic<long> ContadorAlocacoes::alocacoes(0);
+
+void RelatorioMemoria::iniciarAmostra() {
+    for (Componente& componente : componentes) {
+        componente.atual = UsoMemoria();
+        componente.elementos = 0;
+    }
+}
+
+void RelatorioMemoria::registrar(const char* componente, const UsoMemoria& uso, long elementos) {
+    for (Componente& existente : componentes) {
+        if (std::strcmp(existente.nome, componente) == 0) {
+            existente.atual += uso;
+            existente.elementos += elementos;
+            return;
+        }
+    }
+    Componente novo;
+    novo.nome = componente;
+    novo.atual = uso;
+    novo.elementos = elementos;
+    novo.pico = 0;
+    componentes.adicionar(novo);
+}
+
+void RelatorioMemoria::concluirAmostra() {
+    for (Componente& componente : componentes) {
+        if (componente.atual.alocados > componente.pico) {
+            componente.pico = componente.atual.alocados;
+        }
+    }
+}
+
+void RelatorioMemoria::escrever(std::ostream& saida, const std::string& rotulo) const {
+    UsoMemoria total;
+    long elementos = 0;
+    size_t picos = 0;
+    saida << "Memory report (" << rotulo << "):" << std::endl;
+    saida << "structure,elements,allocated_bytes,used_bytes,waste_bytes,peak_bytes" << std::endl;
+    for (const Componente& componente : componentes) {
+        saida << componente.nome << "," << componente.elementos << "," << componente.atual.alocados << ","
+              << componente.atual.usados << "," << componente.atual.alocados - componente.atual.usados << ","
+              << componente.pico << std::endl;
+        total += componente.atual;
+        elementos += componente.elementos;
+        picos += componente.pico;
+    }
+    // A soma dos picos limita por cima o pico do total, pois eles podem ocorrer em amostras diferentes.
+    saida << "total," << elementos << "," << total.alocados << "," << total.usados << ","
+          << total.alocados - total.usados << "," << picos << std::endl;
+    if (ContadorAlocacoes::ativo()) {
+        saida << "Lista/Mapa arrays: " << ContadorAlocacoes::getBytesVivos() << " bytes live, "
+              << ContadorAlocacoes::getPicoBytes() << " peak, " << ContadorAlocacoes::getAlocacoes()
+              << " allocations" << std::endl;
+    }
+    saida << "Process RSS: " << lerStatusProcesso("VmRSS") << " KiB, peak " << lerStatusProcesso("VmHWM")
+          << " KiB" << std::endl;
+}
+
+long RelatorioMemoria::lerStatusProcesso(const char* campo) {
+    std::ifstream arquivo("/proc/self/status");
+    std::string chave = std::string(campo) + ":";
+    std::string palavra;
+    while (arquivo >> palavra) {
+        if (palavra == chave) {
+            long valor = -1;
+            arquivo >> valor;
+            return valor;
+        }
+    }
+    return -1;
+}
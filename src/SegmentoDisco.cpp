@@ -0,0 +1,372 @@
+#include "../include/SegmentoDisco.hpp"
+#include <cstring>
+#include <fstream>
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @file SegmentoDisco.cpp
+ * @brief Implementação da classe SegmentoDisco.
+ */
+
+static const char MAGICA_SEGMENTO[4] = {'T', 'P', '3', 'S'};
+static const uint32_t VERSAO_SEGMENTO = 2;
+
+namespace {
+    bool precedeInteiro(const int& a, const int& b) {
+        return a < b;
+    }
+
+    /**
+     * @brief Entrega os históricos residentes, já codificados, e os timestamps de seus eventos por tipo.
+     */
+    class FonteMemoria {
+    public:
+        FonteMemoria(const Lista<int>& ids, const Lista<VisaoHistorico>& historicos)
+            : ids(ids), historicos(historicos), proximo(0), cursorTempos(0) {
+            Lista<Evento> eventos;
+            for (int i = 0; i < historicos.getTamanho(); ++i) {
+                eventos.limpar();
+                historicos[i].decodificarAte(INT_MAX, ids[i], eventos);
+                for (const Evento& ev : eventos) {
+                    temposPorTipo[ev.tipo].adicionar(ev.dataHora);
+                }
+            }
+            for (int t = 0; t <= INDEFINIDO; ++t) {
+                temposPorTipo[t].ordenarMesclando(precedeInteiro);
+            }
+        }
+
+        bool proximoPacote(int& id, VisaoHistorico& historico) {
+            if (proximo >= ids.getTamanho()) return false;
+            id = ids[proximo];
+            historico = historicos[proximo++];
+            return true;
+        }
+
+        void reiniciarTempos(int tipo) {
+            tipoAtual = tipo;
+            cursorTempos = 0;
+        }
+
+        bool proximoTempo(int& tempo) {
+            if (cursorTempos >= temposPorTipo[tipoAtual].getTamanho()) return false;
+            tempo = temposPorTipo[tipoAtual][cursorTempos++];
+            return true;
+        }
+
+    private:
+        const Lista<int>& ids;
+        const Lista<VisaoHistorico>& historicos;
+        int proximo;
+        Lista<int> temposPorTipo[INDEFINIDO + 1];
+        int tipoAtual;
+        int cursorTempos;
+    };
+
+    /**
+     * @brief Intercala vários segmentos por ID do pacote, unindo os históricos de um mesmo pacote.
+     */
+    class FonteMescla {
+    public:
+        FonteMescla(SegmentoDisco* const* segmentos, int quantidade)
+            : segmentos(segmentos), quantidade(quantidade), tipoAtual(0) {
+            cursores = new int[quantidade];
+            for (int i = 0; i < quantidade; ++i) cursores[i] = 0;
+        }
+
+        ~FonteMescla() { delete[] cursores; }
+
+        bool proximoPacote(int& id, VisaoHistorico& historico) {
+            int menorId = 0;
+            bool encontrado = false;
+            for (int i = 0; i < quantidade; ++i) {
+                if (cursores[i] < segmentos[i]->getQuantidadePacotes()) {
+                    int candidato = segmentos[i]->idPacote(cursores[i]);
+                    if (!encontrado || candidato < menorId) {
+                        menorId = candidato;
+                        encontrado = true;
+                    }
+                }
+            }
+            if (!encontrado) return false;
+
+            // Um pacote presente em um único segmento é copiado sem recodificação.
+            Lista<VisaoHistorico> partes;
+            for (int i = 0; i < quantidade; ++i) {
+                if (cursores[i] < segmentos[i]->getQuantidadePacotes() &&
+                    segmentos[i]->idPacote(cursores[i]) == menorId) {
+                    partes.adicionar(segmentos[i]->historico(cursores[i]++));
+                }
+            }
+            id = menorId;
+            if (partes.getTamanho() == 1) {
+                historico = partes[0];
+                return true;
+            }
+
+            // A ordenação estável mantém os eventos dos segmentos mais antigos primeiro nos empates.
+            Lista<Evento> eventos;
+            for (int i = 0; i < partes.getTamanho(); ++i) {
+                partes[i].decodificarAte(INT_MAX, id, eventos);
+            }
+            eventos.ordenarMesclando(precedeNoTempo);
+            unido.limpar();
+            for (int i = 0; i < eventos.getTamanho(); ++i) {
+                unido.adicionar(eventos[i]);
+            }
+            historico = unido.visao();
+            return true;
+        }
+
+        void reiniciarTempos(int tipo) {
+            tipoAtual = tipo;
+            for (int i = 0; i < quantidade; ++i) cursores[i] = 0;
+        }
+
+        bool proximoTempo(int& tempo) {
+            int escolhido = -1;
+            int menor = 0;
+            for (int i = 0; i < quantidade; ++i) {
+                if (cursores[i] < segmentos[i]->getQuantidadeTipo(tipoAtual)) {
+                    int candidato = segmentos[i]->tempoTipo(tipoAtual, cursores[i]);
+                    if (escolhido < 0 || candidato < menor) {
+                        escolhido = i;
+                        menor = candidato;
+                    }
+                }
+            }
+            if (escolhido < 0) return false;
+            cursores[escolhido]++;
+            tempo = menor;
+            return true;
+        }
+
+    private:
+        SegmentoDisco* const* segmentos;
+        int quantidade;
+        int* cursores; ///< Posição em cada segmento: no diretório, e depois nos timestamps do tipo atual.
+        int tipoAtual;
+        HistoricoPacote unido;
+
+        static bool precedeNoTempo(const Evento& a, const Evento& b) {
+            return a.dataHora < b.dataHora;
+        }
+    };
+}
+
+SegmentoDisco::SegmentoDisco()
+    : descritor(-1), mapa(nullptr), tamanhoMapa(0), cabecalho(nullptr), dados(nullptr), diretorio(nullptr),
+      marcadores(nullptr), descartar(false) {
+    for (int t = 0; t <= INDEFINIDO; ++t) {
+        tempos[t] = nullptr;
+    }
+}
+
+SegmentoDisco::~SegmentoDisco() {
+    if (mapa != nullptr) {
+        munmap(mapa, tamanhoMapa);
+    }
+    if (descritor >= 0) {
+        close(descritor);
+    }
+    if (descartar) {
+        unlink(caminho.c_str());
+    }
+}
+
+template <typename Fonte>
+bool SegmentoDisco::escrever(const std::string& caminho, Fonte& fonte) {
+    std::ofstream arquivo(caminho.c_str(), std::ios::binary | std::ios::trunc);
+    if (!arquivo.is_open()) {
+        return false;
+    }
+
+    Cabecalho cab;
+    std::memset(&cab, 0, sizeof(cab));
+    std::memcpy(cab.magica, MAGICA_SEGMENTO, sizeof(cab.magica));
+    cab.versao = VERSAO_SEGMENTO;
+    cab.tempoMinimo = INT_MAX;
+    cab.tempoMaximo = INT_MIN;
+    arquivo.write(reinterpret_cast<const char*>(&cab), sizeof(cab)); // Reescrito ao final.
+
+    // 1. Os históricos, em sequência; o diretório e os marcadores, bem menores,
+    //    são acumulados para serem gravados depois deles.
+    Lista<Entrada> entradas;
+    Lista<MarcadorHistorico> todosMarcadores;
+    int id;
+    VisaoHistorico historico;
+    while (fonte.proximoPacote(id, historico)) {
+        Entrada entrada;
+        entrada.idPacote = id;
+        entrada.quantidade = historico.getQuantidade();
+        entrada.registros = historico.getRegistros();
+        entrada.primeiroMarcador = static_cast<uint32_t>(todosMarcadores.getTamanho());
+        entrada.deslocamento = cab.tamanhoDados;
+        entrada.tamanho = static_cast<uint32_t>(historico.getTamanhoBytes());
+        entradas.adicionar(entrada);
+
+        int marcadoresPacote = VisaoHistorico::quantidadeMarcadores(historico.getQuantidade());
+        for (int i = 0; i < marcadoresPacote; ++i) {
+            todosMarcadores.adicionar(historico.getMarcadores()[i]);
+        }
+        arquivo.write(reinterpret_cast<const char*>(historico.getBytes()), historico.getTamanhoBytes());
+        cab.tamanhoDados += entrada.tamanho;
+        cab.quantidadeEventos += static_cast<uint32_t>(entrada.quantidade);
+    }
+
+    // 2. Diretório e marcadores, alinhados a 4 bytes.
+    static const char zeros[4] = {0, 0, 0, 0};
+    arquivo.write(zeros, (4 - cab.tamanhoDados % 4) % 4);
+    cab.deslocamentoDiretorio = static_cast<uint32_t>(sizeof(Cabecalho)) + (cab.tamanhoDados + 3) / 4 * 4;
+    cab.quantidadePacotes = static_cast<uint32_t>(entradas.getTamanho());
+    cab.quantidadeMarcadores = static_cast<uint32_t>(todosMarcadores.getTamanho());
+    arquivo.write(reinterpret_cast<const char*>(entradas.dados()), sizeof(Entrada) * entradas.getTamanho());
+    arquivo.write(reinterpret_cast<const char*>(todosMarcadores.dados()),
+                  sizeof(MarcadorHistorico) * todosMarcadores.getTamanho());
+
+    // 3. Os timestamps de cada tipo, ordenados.
+    for (int t = 0; t <= INDEFINIDO; ++t) {
+        fonte.reiniciarTempos(t);
+        int tempo;
+        while (fonte.proximoTempo(tempo)) {
+            int32_t valor = tempo;
+            arquivo.write(reinterpret_cast<const char*>(&valor), sizeof(valor));
+            cab.contagens[t]++;
+            if (tempo < cab.tempoMinimo) cab.tempoMinimo = tempo;
+            if (tempo > cab.tempoMaximo) cab.tempoMaximo = tempo;
+        }
+    }
+
+    arquivo.seekp(0);
+    arquivo.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    arquivo.close();
+    return !arquivo.fail();
+}
+
+bool SegmentoDisco::gravar(const std::string& caminho, const Lista<int>& ids,
+                           const Lista<VisaoHistorico>& historicos) {
+    FonteMemoria fonte(ids, historicos);
+    return escrever(caminho, fonte);
+}
+
+bool SegmentoDisco::mesclar(const std::string& caminho, SegmentoDisco* const* segmentos, int quantidade) {
+    FonteMescla fonte(segmentos, quantidade);
+    return escrever(caminho, fonte);
+}
+
+SegmentoDisco* SegmentoDisco::abrir(const std::string& caminho) {
+    SegmentoDisco* segmento = new SegmentoDisco();
+    segmento->caminho = caminho;
+
+    struct stat info;
+    segmento->descritor = open(caminho.c_str(), O_RDONLY);
+    if (segmento->descritor < 0 || fstat(segmento->descritor, &info) != 0 ||
+        static_cast<size_t>(info.st_size) < sizeof(Cabecalho)) {
+        delete segmento;
+        return nullptr;
+    }
+
+    segmento->tamanhoMapa = static_cast<size_t>(info.st_size);
+    void* mapa = mmap(nullptr, segmento->tamanhoMapa, PROT_READ, MAP_PRIVATE, segmento->descritor, 0);
+    if (mapa == MAP_FAILED) {
+        delete segmento;
+        return nullptr;
+    }
+    segmento->mapa = mapa;
+
+    const char* base = static_cast<const char*>(mapa);
+    segmento->cabecalho = reinterpret_cast<const Cabecalho*>(base);
+    const Cabecalho* cab = segmento->cabecalho;
+    size_t esperado = static_cast<size_t>(cab->deslocamentoDiretorio) +
+                      static_cast<size_t>(cab->quantidadePacotes) * sizeof(Entrada) +
+                      static_cast<size_t>(cab->quantidadeMarcadores) * sizeof(MarcadorHistorico) +
+                      static_cast<size_t>(cab->quantidadeEventos) * sizeof(int32_t);
+    if (std::memcmp(cab->magica, MAGICA_SEGMENTO, sizeof(cab->magica)) != 0 ||
+        cab->versao != VERSAO_SEGMENTO || esperado != segmento->tamanhoMapa) {
+        delete segmento;
+        return nullptr;
+    }
+
+    segmento->dados = reinterpret_cast<const unsigned char*>(base + sizeof(Cabecalho));
+    segmento->diretorio = reinterpret_cast<const Entrada*>(base + cab->deslocamentoDiretorio);
+    segmento->marcadores = reinterpret_cast<const MarcadorHistorico*>(segmento->diretorio + cab->quantidadePacotes);
+    const int32_t* tempos = reinterpret_cast<const int32_t*>(segmento->marcadores + cab->quantidadeMarcadores);
+    for (int t = 0; t <= INDEFINIDO; ++t) {
+        segmento->tempos[t] = tempos;
+        tempos += cab->contagens[t];
+    }
+
+    for (int i = 0; i < segmento->getQuantidadePacotes(); i += PASSO_INDICE) {
+        segmento->indiceEsparso.adicionar(segmento->diretorio[i].idPacote);
+    }
+    return segmento;
+}
+
+VisaoHistorico SegmentoDisco::historico(int entrada) const {
+    const Entrada& e = diretorio[entrada];
+    return VisaoHistorico(dados + e.deslocamento, e.tamanho, marcadores + e.primeiroMarcador,
+                          e.quantidade, e.registros);
+}
+
+VisaoHistorico SegmentoDisco::buscarPacote(int idPacote) const {
+    // Último bloco do índice que começa com um ID até o procurado.
+    int esquerda = 0;
+    int direita = indiceEsparso.getTamanho() - 1;
+    int bloco = 0;
+    while (esquerda <= direita) {
+        int meio = (esquerda + direita) / 2;
+        if (indiceEsparso[meio] <= idPacote) {
+            bloco = meio;
+            esquerda = meio + 1;
+        } else {
+            direita = meio - 1;
+        }
+    }
+
+    // Busca binária dentro do bloco, que ocupa poucas páginas do diretório.
+    esquerda = bloco * PASSO_INDICE;
+    direita = esquerda + PASSO_INDICE - 1;
+    if (direita >= getQuantidadePacotes()) {
+        direita = getQuantidadePacotes() - 1;
+    }
+    while (esquerda <= direita) {
+        int meio = (esquerda + direita) / 2;
+        if (diretorio[meio].idPacote < idPacote) {
+            esquerda = meio + 1;
+        } else if (diretorio[meio].idPacote > idPacote) {
+            direita = meio - 1;
+        } else {
+            return historico(meio);
+        }
+    }
+    return VisaoHistorico();
+}
+
+void SegmentoDisco::contarEventos(int tempo, long* contagens) const {
+    if (getQuantidade() == 0 || tempo < cabecalho->tempoMinimo) {
+        return;
+    }
+    for (int t = 0; t <= INDEFINIDO; ++t) {
+        int n = static_cast<int>(cabecalho->contagens[t]);
+        if (tempo >= cabecalho->tempoMaximo) {
+            contagens[t] += n;
+            continue;
+        }
+        // Número de timestamps até `tempo` na lista ordenada do tipo.
+        int esquerda = 0;
+        int direita = n;
+        while (esquerda < direita) {
+            int meio = (esquerda + direita) / 2;
+            if (tempos[t][meio] <= tempo) {
+                esquerda = meio + 1;
+            } else {
+                direita = meio;
+            }
+        }
+        contagens[t] += esquerda;
+    }
+}
@@ -0,0 +1,369 @@
+#include "../include/VarreduraEscala.hpp"
+#include "../include/RelatorioMemoria.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/**
+ * @file VarreduraEscala.cpp
+ * @brief Implementação da classe VarreduraEscala.
+ */
+
+namespace {
+    const int NUMERO_EXPERIMENTOS = 4;
+    const char* const NOMES_EXPERIMENTOS[NUMERO_EXPERIMENTOS] = {"packets", "clients", "num_cl", "num_pc"};
+
+    /**
+     * @brief Gerador xorshift64*: rápido, determinístico e igual em qualquer plataforma.
+     */
+    class Aleatorio {
+    public:
+        explicit Aleatorio(uint64_t semente) : estado(semente != 0 ? semente : 0x9E3779B97F4A7C15ULL) {}
+
+        uint64_t proximo() {
+            estado ^= estado >> 12;
+            estado ^= estado << 25;
+            estado ^= estado >> 27;
+            return estado * 0x2545F4914F6CDD1DULL;
+        }
+
+        /**
+         * @brief Um inteiro uniforme em `[minimo, maximo]`.
+         */
+        int entre(int minimo, int maximo) {
+            return minimo + static_cast<int>(proximo() % static_cast<uint64_t>(maximo - minimo + 1));
+        }
+
+    private:
+        uint64_t estado;
+    };
+
+    std::string nomeCliente(int indice) {
+        char nome[16];
+        std::snprintf(nome, sizeof(nome), "n%05d", indice);
+        return nome;
+    }
+
+    bool precedeNoTempo(const Evento& a, const Evento& b) {
+        return a.dataHora < b.dataHora;
+    }
+
+    bool menorDouble(const double& a, const double& b) {
+        return a < b;
+    }
+
+    double mediana(Lista<double> valores) {
+        if (valores.getTamanho() == 0) {
+            return 0;
+        }
+        valores.ordenarMesclando(menorDouble);
+        return valores[valores.getTamanho() / 2];
+    }
+
+    /**
+     * @brief Percentil pelo método do posto mais próximo, sobre uma lista já ordenada.
+     */
+    double percentil(const Lista<double>& ordenados, double p) {
+        int n = ordenados.getTamanho();
+        if (n == 0) {
+            return 0;
+        }
+        int posto = static_cast<int>(std::ceil(p / 100.0 * n));
+        if (posto < 1) posto = 1;
+        if (posto > n) posto = n;
+        return ordenados[posto - 1];
+    }
+
+    /**
+     * @brief Zera o pico de memória residente do processo (`VmHWM`), se o kernel permitir.
+     *
+     * Antes, devolve ao sistema a memória livre do alocador, para que o pico do
+     * próximo ponto não parta da memória residente deixada pelos anteriores.
+     */
+    bool reiniciarPicoRss() {
+#ifdef __GLIBC__
+        malloc_trim(0);
+#endif
+        std::ofstream arquivo("/proc/self/clear_refs");
+        arquivo << "5";
+        arquivo.close();
+        return !arquivo.fail();
+    }
+
+    Evento novoEvento(int tempo, TipoEvento tipo, int idPacote, int origem, int destino, int secao) {
+        Evento ev;
+        ev.dataHora = tempo;
+        ev.tipo = tipo;
+        ev.idPacote = idPacote;
+        ev.armazemOrigem = origem;
+        ev.armazemDestino = destino;
+        ev.secaoDestino = secao;
+        return ev;
+    }
+}
+
+VarreduraEscala::VarreduraEscala(const ParametrosVarredura& parametros, const OpcoesMotor& opcoes)
+    : parametros(parametros), opcoes(opcoes) {}
+
+void VarreduraEscala::gerarCarga(int pacotes, int clientes, int consultasCL, int consultasPC, uint64_t semente,
+                                 Carga& carga) const {
+    Aleatorio aleatorio(semente);
+    int armazens = parametros.armazens < 2 ? 2 : parametros.armazens;
+    int horizonte = pacotes * 10; // Como no genwkl3, as postagens se espalham no tempo com o número de pacotes.
+
+    int maiorTempo = 1;
+    for (int p = 0; p < pacotes; ++p) {
+        int remetente = aleatorio.entre(0, clientes - 1);
+        int destinatario = aleatorio.entre(0, clientes - 1);
+        int origem = aleatorio.entre(0, armazens - 1);
+        int destino = aleatorio.entre(0, armazens - 1);
+
+        // Rota: até três armazéns intermediários distintos do anterior, terminando no destino.
+        int rota[5];
+        int paradas = 0;
+        rota[paradas++] = origem;
+        int intermediarios = aleatorio.entre(0, 3);
+        for (int i = 0; i < intermediarios; ++i) {
+            int proximo = aleatorio.entre(0, armazens - 1);
+            if (proximo != rota[paradas - 1]) {
+                rota[paradas++] = proximo;
+            }
+        }
+        if (destino != rota[paradas - 1]) {
+            rota[paradas++] = destino;
+        }
+
+        int tempo = aleatorio.entre(1, horizonte);
+        Evento registro = novoEvento(tempo, RG, p, origem, destino, -1);
+        registro.remetente = nomeCliente(remetente);
+        registro.destinatario = nomeCliente(destinatario);
+        carga.eventos.adicionar(registro);
+
+        for (int i = 0; i < paradas; ++i) {
+            int proxima = (i + 1 < paradas) ? rota[i + 1] : destino;
+            tempo += aleatorio.entre(1, 10);
+            carga.eventos.adicionar(novoEvento(tempo, AR, p, rota[i], -1, proxima));
+            if (i + 1 < paradas) {
+                tempo += aleatorio.entre(5, 40);
+                carga.eventos.adicionar(novoEvento(tempo, RM, p, rota[i], -1, proxima));
+                carga.eventos.adicionar(novoEvento(tempo, TR, p, rota[i], proxima, -1));
+            }
+        }
+        tempo += aleatorio.entre(5, 40);
+        carga.eventos.adicionar(novoEvento(tempo, EN, p, -1, destino, -1));
+        if (tempo > maiorTempo) {
+            maiorTempo = tempo;
+        }
+    }
+    carga.eventos.ordenarMesclando(precedeNoTempo);
+
+    for (int i = 0; i < consultasCL; ++i) {
+        carga.temposCL.adicionar(aleatorio.entre(1, maiorTempo));
+        carga.clientesCL.adicionar(nomeCliente(aleatorio.entre(0, clientes - 1)));
+    }
+    for (int i = 0; i < consultasPC; ++i) {
+        carga.temposPC.adicionar(aleatorio.entre(1, maiorTempo));
+        carga.pacotesPC.adicionar(aleatorio.entre(0, pacotes - 1));
+    }
+}
+
+void VarreduraEscala::medirPonto(int experimento, int pacotes, int clientes, int consultasCL, int consultasPC) {
+    typedef std::chrono::steady_clock Relogio;
+
+    Carga carga;
+    gerarCarga(pacotes, clientes, consultasCL, consultasPC, parametros.semente, carga);
+    reiniciarPicoRss();
+
+    Lista<double> msIngestao;
+    Lista<double> msConsultas;
+    Lista<double> latenciasCL;
+    Lista<double> latenciasPC;
+    long checagem = 0; // Evita que o compilador descarte as consultas.
+
+    for (int r = 0; r < parametros.aquecimento + parametros.repeticoes; ++r) {
+        bool medida = r >= parametros.aquecimento;
+        MotorLogistico motor(opcoes);
+
+        Relogio::time_point inicio = Relogio::now();
+        motor.ingerirLote(carga.eventos.dados(), carga.eventos.getTamanho());
+        Relogio::time_point fimIngestao = Relogio::now();
+
+        for (int i = 0; i < consultasCL; ++i) {
+            Relogio::time_point antes = Relogio::now();
+            checagem += motor.consultarCliente(carga.temposCL[i], carga.clientesCL[i]).getTamanho();
+            std::chrono::duration<double, std::micro> duracao = Relogio::now() - antes;
+            if (medida) latenciasCL.adicionar(duracao.count());
+        }
+        for (int i = 0; i < consultasPC; ++i) {
+            Relogio::time_point antes = Relogio::now();
+            checagem += motor.consultarPacote(carga.temposPC[i], carga.pacotesPC[i]).getTamanho();
+            std::chrono::duration<double, std::micro> duracao = Relogio::now() - antes;
+            if (medida) latenciasPC.adicionar(duracao.count());
+        }
+        Relogio::time_point fim = Relogio::now();
+
+        if (medida) {
+            msIngestao.adicionar(std::chrono::duration<double, std::milli>(fimIngestao - inicio).count());
+            msConsultas.adicionar(std::chrono::duration<double, std::milli>(fim - fimIngestao).count());
+        }
+    }
+
+    Ponto ponto;
+    ponto.experimento = experimento;
+    ponto.pacotes = pacotes;
+    ponto.clientes = clientes;
+    ponto.consultasCL = consultasCL;
+    ponto.consultasPC = consultasPC;
+    ponto.eventos = carga.eventos.getTamanho();
+    ponto.msIngestao = mediana(msIngestao);
+    ponto.msConsultas = mediana(msConsultas);
+    latenciasCL.ordenarMesclando(menorDouble);
+    latenciasPC.ordenarMesclando(menorDouble);
+    const double percentis[3] = {50, 95, 99};
+    for (int i = 0; i < 3; ++i) {
+        ponto.latenciaCL[i] = percentil(latenciasCL, percentis[i]);
+        ponto.latenciaPC[i] = percentil(latenciasPC, percentis[i]);
+    }
+    ponto.picoRssKiB = RelatorioMemoria::lerStatusProcesso("VmHWM");
+    pontos.adicionar(ponto);
+
+    std::cerr << "sweep: " << NOMES_EXPERIMENTOS[experimento] << " packets=" << pacotes << " clients=" << clientes
+              << " num_cl=" << consultasCL << " num_pc=" << consultasPC << " ingest=" << ponto.msIngestao
+              << " ms queries=" << ponto.msConsultas << " ms results=" << checagem << std::endl;
+}
+
+void VarreduraEscala::executar(std::ostream& saida) {
+    const int base[NUMERO_EXPERIMENTOS] = {parametros.pacotes, parametros.clientes,
+                                           parametros.consultasCL, parametros.consultasPC};
+    int numeroPontos = parametros.pontos < 1 ? 1 : parametros.pontos;
+    if (!reiniciarPicoRss()) {
+        std::cerr << "sweep: cannot reset the peak RSS; peak_rss_kib is the process peak so far" << std::endl;
+    }
+    double fator = parametros.fatorMaximo < 1 ? 1 : parametros.fatorMaximo;
+
+    for (int e = 0; e < NUMERO_EXPERIMENTOS; ++e) {
+        int anterior = -1;
+        for (int i = 0; i < numeroPontos; ++i) {
+            double escala = numeroPontos > 1 ? std::pow(fator, static_cast<double>(i) / (numeroPontos - 1)) : 1;
+            int valores[NUMERO_EXPERIMENTOS];
+            for (int j = 0; j < NUMERO_EXPERIMENTOS; ++j) {
+                valores[j] = base[j];
+            }
+            valores[e] = static_cast<int>(base[e] * escala + 0.5);
+            if (valores[e] < 1 || valores[e] == anterior) {
+                continue; // Pontos repetidos por arredondamento não acrescentam informação.
+            }
+            anterior = valores[e];
+            medirPonto(e, valores[0], valores[1], valores[2], valores[3]);
+        }
+    }
+
+    if (parametros.json) {
+        escreverJson(saida);
+    } else {
+        escreverCsv(saida);
+    }
+}
+
+double VarreduraEscala::ajustarExpoente(const Lista<double>& x, const Lista<double>& y) {
+    int n = 0;
+    double somaX = 0, somaY = 0, somaXX = 0, somaXY = 0;
+    for (int i = 0; i < x.getTamanho(); ++i) {
+        if (x[i] <= 0 || y[i] <= 0) {
+            continue;
+        }
+        double lx = std::log(x[i]);
+        double ly = std::log(y[i]);
+        somaX += lx;
+        somaY += ly;
+        somaXX += lx * lx;
+        somaXY += lx * ly;
+        n++;
+    }
+    double denominador = n * somaXX - somaX * somaX;
+    if (n < 2 || denominador <= 0) {
+        return 0;
+    }
+    return (n * somaXY - somaX * somaY) / denominador;
+}
+
+void VarreduraEscala::ajustarExperimento(int experimento, double& expoenteIngestao,
+                                         double& expoenteConsultas) const {
+    Lista<double> x, ingestao, consultas;
+    for (const Ponto& p : pontos) {
+        if (p.experimento == experimento) {
+            const int valores[NUMERO_EXPERIMENTOS] = {p.pacotes, p.clientes, p.consultasCL, p.consultasPC};
+            x.adicionar(valores[experimento]);
+            ingestao.adicionar(p.msIngestao);
+            consultas.adicionar(p.msConsultas);
+        }
+    }
+    expoenteIngestao = ajustarExpoente(x, ingestao);
+    expoenteConsultas = ajustarExpoente(x, consultas);
+}
+
+namespace {
+    double porSegundo(double quantidade, double ms) {
+        return ms > 0 ? quantidade * 1000.0 / ms : 0;
+    }
+}
+
+void VarreduraEscala::escreverCsv(std::ostream& saida) const {
+    saida << std::fixed << std::setprecision(3);
+    saida << "experiment,packets,clients,num_cl,num_pc,events,ingest_ms,ingest_events_per_s,query_ms,"
+             "queries_per_s,cl_p50_us,cl_p95_us,cl_p99_us,pc_p50_us,pc_p95_us,pc_p99_us,peak_rss_kib" << std::endl;
+    for (const Ponto& p : pontos) {
+        saida << NOMES_EXPERIMENTOS[p.experimento] << "," << p.pacotes << "," << p.clientes << ","
+              << p.consultasCL << "," << p.consultasPC << "," << p.eventos << "," << p.msIngestao << ","
+              << porSegundo(p.eventos, p.msIngestao) << "," << p.msConsultas << ","
+              << porSegundo(p.consultasCL + p.consultasPC, p.msConsultas);
+        for (int i = 0; i < 3; ++i) saida << "," << p.latenciaCL[i];
+        for (int i = 0; i < 3; ++i) saida << "," << p.latenciaPC[i];
+        saida << "," << p.picoRssKiB << std::endl;
+    }
+
+    saida << std::endl << "experiment,ingest_exponent,query_exponent" << std::endl;
+    for (int e = 0; e < NUMERO_EXPERIMENTOS; ++e) {
+        double expoenteIngestao, expoenteConsultas;
+        ajustarExperimento(e, expoenteIngestao, expoenteConsultas);
+        saida << NOMES_EXPERIMENTOS[e] << "," << expoenteIngestao << "," << expoenteConsultas << std::endl;
+    }
+}
+
+void VarreduraEscala::escreverJson(std::ostream& saida) const {
+    saida << std::fixed << std::setprecision(3);
+    saida << "{\n  \"base\": {\"packets\": " << parametros.pacotes << ", \"clients\": " << parametros.clientes
+          << ", \"num_cl\": " << parametros.consultasCL << ", \"num_pc\": " << parametros.consultasPC
+          << ", \"nodes\": " << parametros.armazens << "},\n";
+    saida << "  \"repetitions\": " << parametros.repeticoes << ",\n  \"warmup\": " << parametros.aquecimento
+          << ",\n  \"seed\": " << parametros.semente << ",\n  \"points\": [";
+    for (int i = 0; i < pontos.getTamanho(); ++i) {
+        const Ponto& p = pontos[i];
+        saida << (i > 0 ? "," : "") << "\n    {\"experiment\": \"" << NOMES_EXPERIMENTOS[p.experimento]
+              << "\", \"packets\": " << p.pacotes << ", \"clients\": " << p.clientes
+              << ", \"num_cl\": " << p.consultasCL << ", \"num_pc\": " << p.consultasPC
+              << ", \"events\": " << p.eventos << ", \"ingest_ms\": " << p.msIngestao
+              << ", \"ingest_events_per_s\": " << porSegundo(p.eventos, p.msIngestao)
+              << ", \"query_ms\": " << p.msConsultas
+              << ", \"queries_per_s\": " << porSegundo(p.consultasCL + p.consultasPC, p.msConsultas)
+              << ", \"cl_latency_us\": {\"p50\": " << p.latenciaCL[0] << ", \"p95\": " << p.latenciaCL[1]
+              << ", \"p99\": " << p.latenciaCL[2] << "}"
+              << ", \"pc_latency_us\": {\"p50\": " << p.latenciaPC[0] << ", \"p95\": " << p.latenciaPC[1]
+              << ", \"p99\": " << p.latenciaPC[2] << "}"
+              << ", \"peak_rss_kib\": " << p.picoRssKiB << "}";
+    }
+    saida << "\n  ],\n  \"exponents\": {";
+    for (int e = 0; e < NUMERO_EXPERIMENTOS; ++e) {
+        double expoenteIngestao, expoenteConsultas;
+        ajustarExperimento(e, expoenteIngestao, expoenteConsultas);
+        saida << (e > 0 ? "," : "") << "\n    \"" << NOMES_EXPERIMENTOS[e] << "\": {\"ingest\": "
+              << expoenteIngestao << ", \"query\": " << expoenteConsultas << "}";
+    }
+    saida << "\n  }\n}" << std::endl;
+}
@@ -1,5 +1,8 @@
 #include <iostream>
 #include "../include/Carregamento.hpp"
+#include "../include/ExecutorLote.hpp"
+#include "../include/VarreduraEscala.hpp"
+#include "../include/Rastreamento.hpp"
 
 /**
  * @file main.cpp
@@ -19,23 +22,281 @@
  * @return 0 em caso de sucesso, 1 em caso de erro (e.g., uso incorreto).
  */
 #include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+/**
+ * @brief Interpreta as opções de `--sweep` e executa a varredura de escalabilidade.
+ * @return O código de saída do programa.
+ */
+static int executarVarredura(int argc, char* argv[]) {
+    ParametrosVarredura parametros;
+    for (int i = 2; i < argc; ++i) {
+        std::string opcao(argv[i]);
+        if (opcao == "--formato" && i + 1 < argc) {
+            std::string formato(argv[++i]);
+            if (formato != "csv" && formato != "json") {
+                std::cerr << "Formato inválido: " << formato << std::endl;
+                return 1;
+            }
+            parametros.json = formato == "json";
+        } else if (opcao == "--pontos" && i + 1 < argc) {
+            parametros.pontos = std::atoi(argv[++i]);
+        } else if (opcao == "--fator" && i + 1 < argc) {
+            parametros.fatorMaximo = std::atoi(argv[++i]);
+        } else if (opcao == "--repeticoes" && i + 1 < argc) {
+            parametros.repeticoes = std::atoi(argv[++i]);
+        } else if (opcao == "--aquecimento" && i + 1 < argc) {
+            parametros.aquecimento = std::atoi(argv[++i]);
+        } else if (opcao == "--semente" && i + 1 < argc) {
+            parametros.semente = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "Opção desconhecida: " << opcao << std::endl;
+            return 1;
+        }
+    }
+    if (parametros.pontos < 1 || parametros.fatorMaximo < 1 || parametros.repeticoes < 1 || parametros.aquecimento < 0) {
+        std::cerr << "Parâmetros de varredura inválidos" << std::endl;
+        return 1;
+    }
+
+    VarreduraEscala varredura(parametros);
+    varredura.executar(std::cout);
+    return 0;
+}
+
+/**
+ * @brief Interpreta uma opção do motor, comum à execução de um arquivo e ao modo `--batch`.
+ * @param i O índice da opção em `argv`; avança sobre o valor da opção, se houver.
+ * @return 1 se a opção foi interpretada, 0 se não é uma opção do motor, -1 se o valor é inválido.
+ */
+static int interpretarOpcaoMotor(int argc, char* argv[], int& i, OpcoesMotor& opcoes, long& limiteCacheClientes,
+                                 std::string& arquivoRastreamento) {
+    std::string opcao(argv[i]);
+    if (opcao == "--cache-cl" && i + 1 < argc) {
+        limiteCacheClientes = std::atol(argv[++i]);
+        if (limiteCacheClientes < 0) {
+            std::cerr << "Limite de cache inválido: " << argv[i] << std::endl;
+            return -1;
+        }
+    } else if (opcao == "--retencao" && i + 1 < argc) {
+        opcoes.janelaRetencao = std::atoi(argv[++i]);
+        if (opcoes.janelaRetencao < 0) {
+            std::cerr << "Janela de retenção inválida: " << argv[i] << std::endl;
+            return -1;
+        }
+    } else if (opcao == "--memoria-max" && i + 1 < argc) {
+        opcoes.memoriaMaxima = std::atol(argv[++i]) * 1024;
+        if (opcoes.memoriaMaxima <= 0) {
+            std::cerr << "Orçamento de memória inválido: " << argv[i] << std::endl;
+            return -1;
+        }
+    } else if (opcao == "--dir-segmentos" && i + 1 < argc) {
+        opcoes.diretorioSegmentos = argv[++i];
+    } else if (opcao == "--trace" && i + 1 < argc) {
+        arquivoRastreamento = argv[++i];
+    } else if (opcao == "--topk" && i + 1 < argc) {
+        opcoes.capacidadeRanking = std::atoi(argv[++i]);
+        if (opcoes.capacidadeRanking < 1) {
+            std::cerr << "Tamanho do ranking inválido: " << argv[i] << std::endl;
+            return -1;
+        }
+    } else if (opcao == "--topk-aproximado") {
+        opcoes.rankingAproximado = true;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Interpreta as opções de `--batch` e processa os arquivos listados.
+ * @return O código de saída do programa: 1 se algum arquivo falhou.
+ */
+static int executarLote(int argc, char* argv[]) {
+    OpcoesMotor opcoes;
+    OpcoesLote opcoesLote;
+    Lista<std::string> arquivos;
+    std::string arquivoRastreamento;
+    for (int i = 2; i < argc; ++i) {
+        std::string opcao(argv[i]);
+        if (opcao == "--jobs" && i + 1 < argc) {
+            opcoesLote.threads = std::atoi(argv[++i]);
+            if (opcoesLote.threads < 1) {
+                std::cerr << "Número de threads inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (opcao == "--memoria-lote" && i + 1 < argc) {
+            opcoesLote.memoriaMaxima = std::atol(argv[++i]) * 1024 * 1024;
+            if (opcoesLote.memoriaMaxima <= 0) {
+                std::cerr << "Orçamento de memória inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (opcao == "--dir-saida" && i + 1 < argc) {
+            opcoesLote.diretorioSaida = argv[++i];
+        } else if (opcao == "--manifesto" && i + 1 < argc) {
+            if (!ExecutorLote::lerManifesto(argv[++i], arquivos)) {
+                std::cerr << "Erro ao abrir o manifesto: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (opcao.compare(0, 2, "--") == 0) {
+            int consumida = interpretarOpcaoMotor(argc, argv, i, opcoes, opcoesLote.limiteCacheClientes,
+                                                  arquivoRastreamento);
+            if (consumida < 0) {
+                return 1;
+            }
+            if (consumida == 0) {
+                std::cerr << "Opção desconhecida: " << opcao << std::endl;
+                return 1;
+            }
+        } else {
+            arquivos.adicionar(opcao);
+        }
+    }
+    if (arquivos.getTamanho() == 0) {
+        std::cerr << "Nenhum arquivo de entrada para o lote" << std::endl;
+        return 1;
+    }
+    if (opcoesLote.limiteCacheClientes >= 0) {
+        opcoesLote.limiteCacheClientes *= 1024;
+    }
+
+    if (!arquivoRastreamento.empty()) {
+        Rastreamento::ativar();
+        Rastreamento::nomearThread("principal");
+    }
+
+    ExecutorLote lote(arquivos, opcoesLote, opcoes);
+    int falhas = lote.executar(std::cout);
+
+    if (!arquivoRastreamento.empty() && !Rastreamento::exportar(arquivoRastreamento)) {
+        return 1;
+    }
+    return falhas > 0 ? 1 : 0;
+}
 
 int main(int argc, char* argv[]) {
     // Verifica se o número de argumentos está correto
-    if (argc < 2 || argc > 3) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo_de_entrada> [--timed]" << std::endl;
+    if (argc < 2) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_de_entrada> [--timed] [--pipeline] [--shards <n>] [--atraso-maximo <t>] [--cache-cl <KiB>] [--retencao <t>] [--memoria-max <KiB>] [--dir-segmentos <dir>] [--bench-parser] [--topk <k>] [--topk-aproximado] [--trace <arquivo.json>] [--mem-report] [--mem-report-every <linhas>]" << std::endl;
+        std::cerr << "     " << argv[0] << " --batch [--jobs <n>] [--memoria-lote <MiB>] [--dir-saida <dir>] [--manifesto <arquivo>] [opções do motor] <arquivo>..." << std::endl;
+        std::cerr << "     " << argv[0] << " --sweep [--formato csv|json] [--pontos <n>] [--fator <f>] [--repeticoes <r>] [--aquecimento <w>] [--semente <s>]" << std::endl;
         return 1; // Retorna código de erro
     }
 
-    // Cria um objeto Carregamento com o arquivo fornecido
-    Carregamento carregamento(argv[1]);
+    if (std::string(argv[1]) == "--sweep") {
+        return executarVarredura(argc, argv);
+    }
+    if (std::string(argv[1]) == "--batch") {
+        return executarLote(argc, argv);
+    }
+
+    // Interpreta as opções que seguem o arquivo de entrada
+    OpcoesMotor opcoes;
+    bool comTiming = false;
+    bool benchmarkAnalisador = false;
+    bool pipeline = false;
+    int particoes = 0;
+    int atrasoMaximo = -1;
+    long limiteCacheClientes = -1;
+    long intervaloRelatorioMemoria = -1;
+    std::string arquivoRastreamento;
+    for (int i = 2; i < argc; ++i) {
+        std::string opcao(argv[i]);
+        if (opcao == "--timed") {
+            comTiming = true;
+        } else if (opcao == "--pipeline") {
+            pipeline = true;
+        } else if (opcao == "--shards" && i + 1 < argc) {
+            particoes = std::atoi(argv[++i]);
+            if (particoes < 1) {
+                std::cerr << "Número de partições inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (opcao == "--atraso-maximo" && i + 1 < argc) {
+            atrasoMaximo = std::atoi(argv[++i]);
+            if (atrasoMaximo < 0) {
+                std::cerr << "Atraso máximo inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (opcao == "--bench-parser") {
+            benchmarkAnalisador = true;
+        } else if (opcao == "--mem-report") {
+            if (intervaloRelatorioMemoria < 0) {
+                intervaloRelatorioMemoria = 0;
+            }
+        } else if (opcao == "--mem-report-every" && i + 1 < argc) {
+            intervaloRelatorioMemoria = std::atol(argv[++i]);
+            if (intervaloRelatorioMemoria < 1) {
+                std::cerr << "Intervalo do relatório de memória inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            int consumida = interpretarOpcaoMotor(argc, argv, i, opcoes, limiteCacheClientes, arquivoRastreamento);
+            if (consumida < 0) {
+                return 1;
+            }
+            if (consumida == 0) {
+                std::cerr << "Opção desconhecida: " << opcao << std::endl;
+                return 1;
+            }
+        }
+    }
 
-    // Verifica se o modo de medição de tempo foi solicitado
-    if (argc == 3 && std::string(argv[2]) == "--timed") {
-        carregamento.executarComTiming();
-    } else {
-        carregamento.executar();
+    if (atrasoMaximo >= 0 && (pipeline || particoes > 0)) {
+        std::cerr << "--atraso-maximo não pode ser combinado com --pipeline ou --shards" << std::endl;
+        return 1;
+    }
+
+    if (intervaloRelatorioMemoria > 0 && particoes > 0) {
+        std::cerr << "--mem-report-every não pode ser combinado com --shards" << std::endl;
+        return 1;
+    }
+
+    if (!arquivoRastreamento.empty()) {
+        Rastreamento::ativar();
+        Rastreamento::nomearThread("principal");
+    }
+
+    // O contador precisa ver todas as alocações dos contêineres, desde a primeira.
+    if (intervaloRelatorioMemoria >= 0) {
+        ContadorAlocacoes::ativar();
+    }
+
+    try {
+        // Cria um objeto Carregamento com o arquivo fornecido
+        Carregamento carregamento(argv[1], opcoes);
+        if (limiteCacheClientes >= 0) {
+            carregamento.configurarCacheClientes(static_cast<size_t>(limiteCacheClientes) * 1024);
+        }
+        if (intervaloRelatorioMemoria >= 0) {
+            carregamento.configurarRelatorioMemoria(intervaloRelatorioMemoria);
+        }
+
+        // Verifica se o modo de medição de tempo foi solicitado
+        if (benchmarkAnalisador) {
+            carregamento.executarBenchmarkAnalisador();
+        } else if (atrasoMaximo >= 0) {
+            carregamento.executarComReordenacao(atrasoMaximo);
+        } else if (particoes > 0) {
+            carregamento.executarParticionado(particoes);
+        } else if (pipeline) {
+            carregamento.executarPipeline();
+        } else if (comTiming) {
+            carregamento.executarComTiming();
+        } else {
+            carregamento.executar();
+        }
+    } catch (const std::runtime_error& erro) {
+        // E.g., o diretório dos segmentos em disco não pôde ser criado.
+        std::cerr << "Erro: " << erro.what() << std::endl;
+        return 1;
+    }
+
+    // As threads de todos os modos já terminaram: os anéis podem ser lidos.
+    if (!arquivoRastreamento.empty() && !Rastreamento::exportar(arquivoRastreamento)) {
+        return 1;
     }
 
     return 0; // Retorna sucesso
-}
\ No newline at end of file
+}